@@ -100,6 +100,9 @@
 #define UNIT_V_MSIZE    (UNIT_V_UF + 0)
 #define UNIT_MSIZE      (7 << UNIT_V_MSIZE)
 #define MEMAMOUNT(x)    (x << UNIT_V_MSIZE)
+#define UNIT_V_PAR      (UNIT_V_UF + 3)
+#define UNIT_PAR        (1 << UNIT_V_PAR)
+#define cpu_parallel    ((cpu_unit[0].flags & UNIT_PAR) != 0)
 
 #define TMR_RTC         0
 
@@ -190,34 +193,65 @@ uint8 rank[64] = {
 };
 
 
+#if defined(SIM_ASYNCH_IO)
+/* With SET CPU PARALLEL, CPU 2 runs on its own host thread, so the
+   register selector is per thread. The main thread runs CPU 1 and
+   services the event queue and all I/O. */
+AIO_TLS int         cpu_index;                  /* Current running cpu */
+AIO_TLS int         cpu_thread;                 /* Set in CPU 2 thread */
+pthread_t           cpu_p2_tid;                 /* CPU 2 thread */
+int                 cpu_p2_tcreated = 0;        /* CPU 2 thread exists */
+pthread_mutex_t     cpu_p2_lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t      cpu_p2_cond = PTHREAD_COND_INITIALIZER;
+pthread_cond_t      cpu_p2_done = PTHREAD_COND_INITIALIZER;
+int                 cpu_p2_go = 0;              /* Start request */
+int                 cpu_p2_busy = 0;            /* CPU 2 thread running */
+volatile int        cpu_p2_stop = 0;            /* Pause request */
+volatile t_stat     cpu_p2_reason = SCPE_OK;    /* Why CPU 2 thread stopped */
+#define P2_LOCK()   do { if (cpu_parallel) \
+                             pthread_mutex_lock(&cpu_p2_lock); } while (0)
+#define P2_UNLOCK() do { if (cpu_parallel) \
+                             pthread_mutex_unlock(&cpu_p2_lock); } while (0)
+#else
 int                 cpu_index;                  /* Current running cpu */
+#define cpu_thread      0
+#define cpu_p2_stop     0
+#define cpu_p2_reason   SCPE_OK
+#define P2_LOCK()
+#define P2_UNLOCK()
+#endif
 t_uint64            M[MAXMEMSIZE] = { 0 };      /* memory */
-t_uint64            a_reg[2];                   /* A register */
-t_uint64            b_reg[2];                   /* B register */
-t_uint64            x_reg[2];                   /* extension to B */
-t_uint64            y_reg[2];                   /* extension to A not original */
-uint8               arof_reg[2];                /* True if A full */
-uint8               brof_reg[2];                /* True if B full */
-uint8               gh_reg[2];                  /* G & H source char selectors */
-uint8               kv_reg[2];                  /* K & V dest char selectors */
-uint16              ma_reg[2];                  /* M memory address regiser */
-uint16              s_reg[2];                   /* S Stack pointer */
-uint16              f_reg[2];                   /* F MCSV pointer */
-uint16              r_reg[2];                   /* R PRT pointer */
-t_uint64            p_reg[2];                   /* P insruction buffer */
-uint8               prof_reg[2];                /* True if P valid */
-uint16              t_reg[2];                   /* T current instruction */
-uint8               trof_reg[2];                /* True if T valid */
-uint16              c_reg[2];                   /* C program counter */
-uint16              l_reg[2];                   /* L current syllable pointer */
-uint8               ncsf_reg[2];                /* True if normal state */
-uint8               salf_reg[2];                /* True if subrogram mode */
-uint8               cwmf_reg[2];                /* True if character mode */
-uint16              hltf[2];                    /* True if processor halted */
-uint8               msff_reg[2];                /* Mark stack flag Word mode */
+/* Registers of one processor. Each processor has its own block, padded
+   so that the two never share a cache line when run in parallel. */
+struct proc_state {
+    t_uint64            a;                      /* A register */
+    t_uint64            b;                      /* B register */
+    t_uint64            x;                      /* extension to B */
+    t_uint64            y;                      /* extension to A not original */
+    t_uint64            p;                      /* P insruction buffer */
+    uint16              ma;                     /* M memory address regiser */
+    uint16              s;                      /* S Stack pointer */
+    uint16              f;                      /* F MCSV pointer */
+    uint16              r;                      /* R PRT pointer */
+    uint16              t;                      /* T current instruction */
+    uint16              c;                      /* C program counter */
+    uint16              l;                      /* L current syllable pointer */
+    uint16              hltf;                   /* True if processor halted */
+    uint8               arof;                   /* True if A full */
+    uint8               brof;                   /* True if B full */
+    uint8               gh;                     /* G & H source char selectors */
+    uint8               kv;                     /* K & V dest char selectors */
+    uint8               prof;                   /* True if P valid */
+    uint8               trof;                   /* True if T valid */
+    uint8               ncsf;                   /* True if normal state */
+    uint8               salf;                   /* True if subrogram mode */
+    uint8               cwmf;                   /* True if character mode */
+    uint8               msff;                   /* Mark stack flag Word mode */
+    uint8               varf;                   /* Variant Flag */
+    uint8               q;                      /* Holds error code */
+    uint8               pad[188];               /* Pad to 256 bytes */
+} proc[2];
 #define TFFF MSFF                               /* True state in Char mode */
-uint8               varf_reg[2];                /* Variant Flag */
-uint8               q_reg[2];                   /* Holds error code */
 uint16              IAR;                        /* Interrupt register */
 uint32              iostatus;                   /* Hold status of devices */
 uint8               RTC;                        /* Real time clock counter */
@@ -273,6 +307,15 @@ t_stat              cpu_show_hist(FILE * st, UNIT * uptr, int32 val,
                                   CONST void *desc);
 t_stat              cpu_set_hist(UNIT * uptr, int32 val, CONST char *cptr,
                                  void *desc);
+t_stat              cpu_set_par(UNIT * uptr, int32 val, CONST char *cptr,
+                                 void *desc);
+t_stat              cpu_run(void);
+int                 cpu_brk_test(t_addr loc, uint32 type);
+void                cpu_p2_start(void);
+void                cpu_p2_pause(void);
+void                cpu_p2_wait(void);
+void                cpu_p2_halt(void);
+int                 cpu_p2_halted(void);
 t_stat              cpu_help(FILE *, DEVICE *, UNIT *, int32, const char *);
 /* Interval timer */
 t_stat              rtc_srv(UNIT * uptr);
@@ -292,32 +335,37 @@ UNIT                cpu_unit[] =
     {{ UDATA(rtc_srv, MEMAMOUNT(7)|UNIT_IDLE|UNIT_FIX, MAXMEMSIZE ), 16667 },
     { UDATA(0, UNIT_DISABLE|UNIT_DIS, 0 ), 0 }};
 
+/* Register in both processor blocks */
+#define PRDATA(nm,fld,rdx,wd,fl,desc) \
+      STRDATAD(nm, proc[0].fld, rdx, wd, 0, 2, sizeof(struct proc_state), \
+               fl, desc)
+
 REG                 cpu_reg[] = {
-    {BRDATAD(C, c_reg, 8,15,2,   "Instruction pointer"), REG_FIT},
-    {BRDATAD(L, l_reg, 8,2,2,    "Sylable pointer")},
-    {BRDATA(A, a_reg, 8,48,2), REG_FIT},
-    {BRDATA(B, b_reg, 8,48,2), REG_FIT},
-    {BRDATA(X, x_reg, 8,39,2), REG_FIT},
-    {BRDATA(Y, x_reg, 8,39,2), REG_FIT},
-    {BRDATA(GH, gh_reg, 8,6,2)},
-    {BRDATA(KV, kv_reg, 8,6,2)},
-    {BRDATAD(MA, ma_reg, 8,15,2, "Memory address")},
-    {BRDATAD(S, s_reg, 8,15,2,   "Stack pointer")},
-    {BRDATAD(F, f_reg, 8,15,2,   "Frame pointer")},
-    {BRDATAD(R, r_reg, 8,15,2,   "PRT pointer/Tally")},
-    {BRDATAD(P, p_reg, 8,48,2,   "Last code word cache")},
-    {BRDATAD(T, t_reg, 8,12,2,   "Current instruction")},
-    {BRDATAD(Q, q_reg, 8,8,2,    "Error condition")},
-    {BRDATA(AROF, arof_reg, 2,1,2)},
-    {BRDATA(BROF, brof_reg, 2,1,2)},
-    {BRDATA(PROF, prof_reg, 2,1,2)},
-    {BRDATA(TROF, trof_reg, 2,1,2)},
-    {BRDATA(NCSF, ncsf_reg, 2,1,2)},
-    {BRDATA(SALF, salf_reg, 2,1,2)},
-    {BRDATA(CWMF, cwmf_reg, 2,1,2)},
-    {BRDATA(MSFF, msff_reg, 2,1,2)},
-    {BRDATA(VARF, varf_reg, 2,1,2)},
-    {BRDATA(HLTF, hltf, 2,1,2)},
+    {PRDATA(C, c, 8, 15, REG_FIT, "Instruction pointer")},
+    {PRDATA(L, l, 8, 2, 0, "Sylable pointer")},
+    {PRDATA(A, a, 8, 48, REG_FIT, NULL)},
+    {PRDATA(B, b, 8, 48, REG_FIT, NULL)},
+    {PRDATA(X, x, 8, 39, REG_FIT, NULL)},
+    {PRDATA(Y, x, 8, 39, REG_FIT, NULL)},
+    {PRDATA(GH, gh, 8, 6, 0, NULL)},
+    {PRDATA(KV, kv, 8, 6, 0, NULL)},
+    {PRDATA(MA, ma, 8, 15, 0, "Memory address")},
+    {PRDATA(S, s, 8, 15, 0, "Stack pointer")},
+    {PRDATA(F, f, 8, 15, 0, "Frame pointer")},
+    {PRDATA(R, r, 8, 15, 0, "PRT pointer/Tally")},
+    {PRDATA(P, p, 8, 48, 0, "Last code word cache")},
+    {PRDATA(T, t, 8, 12, 0, "Current instruction")},
+    {PRDATA(Q, q, 8, 8, 0, "Error condition")},
+    {PRDATA(AROF, arof, 2, 1, 0, NULL)},
+    {PRDATA(BROF, brof, 2, 1, 0, NULL)},
+    {PRDATA(PROF, prof, 2, 1, 0, NULL)},
+    {PRDATA(TROF, trof, 2, 1, 0, NULL)},
+    {PRDATA(NCSF, ncsf, 2, 1, 0, NULL)},
+    {PRDATA(SALF, salf, 2, 1, 0, NULL)},
+    {PRDATA(CWMF, cwmf, 2, 1, 0, NULL)},
+    {PRDATA(MSFF, msff, 2, 1, 0, NULL)},
+    {PRDATA(VARF, varf, 2, 1, 0, NULL)},
+    {PRDATA(HLTF, hltf, 2, 1, 0, NULL)},
     {ORDATAD(IAR, IAR, 15,      "Interrupt pending")},
     {ORDATAD(TUS, iostatus, 32, "Perpherial ready status"), REG_RO},
     {FLDATA(HALT, HALT, 0)},
@@ -339,8 +387,17 @@ MTAB                cpu_mod[] = {
     {UNIT_MSIZE|MTAB_VDV, MEMAMOUNT(7), NULL, "32K", &cpu_set_size},
     {MTAB_XTD|MTAB_VDV, 0, "IDLE", "IDLE", &sim_set_idle, &sim_show_idle },
     {MTAB_XTD|MTAB_VDV, 0, NULL, "NOIDLE", &sim_clr_idle, NULL },
+    {MTAB_XTD|MTAB_VDV, 0, "FASTIO", "FASTIO", &sim_set_fastio, &sim_show_fastio },
+    {MTAB_XTD|MTAB_VDV, 0, NULL, "NOFASTIO", &sim_clr_fastio, NULL },
+    {MTAB_XTD|MTAB_VDV|MTAB_VALO|MTAB_NMO, 1, "PROFILE", "PROFILE",
+       &sim_set_profile, &sim_show_profile, NULL, "Enable instruction profile, PROFILE=RESET clears counts"},
+    {MTAB_XTD|MTAB_VDV, 0, NULL, "NOPROFILE", &sim_set_profile, NULL, NULL, "Disable instruction profile"},
     {MTAB_XTD | MTAB_VDV | MTAB_NMO | MTAB_SHP, 0, "HISTORY", "HISTORY",
      &cpu_set_hist, &cpu_show_hist},
+    {UNIT_PAR, UNIT_PAR, "PARALLEL", "PARALLEL", &cpu_set_par, NULL, NULL,
+       "Run CPU 2 on its own host thread"},
+    {UNIT_PAR, 0, NULL, "NOPARALLEL", &cpu_set_par, NULL, NULL,
+       "Interleave CPU 2 with CPU 1 (default)"},
     {0}
 };
 
@@ -355,31 +412,31 @@ DEVICE              cpu_dev = {
 
 
 /* Define registers */
-#define A       a_reg[cpu_index]
-#define B       b_reg[cpu_index]
-#define C       c_reg[cpu_index]
-#define L       l_reg[cpu_index]
-#define X       x_reg[cpu_index]
-#define Y       y_reg[cpu_index]
-#define Q       q_reg[cpu_index]
-#define GH      gh_reg[cpu_index]
-#define KV      kv_reg[cpu_index]
-#define Ma      ma_reg[cpu_index]
-#define S       s_reg[cpu_index]
-#define F       f_reg[cpu_index]
-#define R       r_reg[cpu_index]
-#define P       p_reg[cpu_index]
-#define T       t_reg[cpu_index]
-#define AROF    arof_reg[cpu_index]
-#define BROF    brof_reg[cpu_index]
-#define PROF    prof_reg[cpu_index]
-#define TROF    trof_reg[cpu_index]
-#define NCSF    ncsf_reg[cpu_index]
-#define SALF    salf_reg[cpu_index]
-#define CWMF    cwmf_reg[cpu_index]
-#define MSFF    msff_reg[cpu_index]
-#define VARF    varf_reg[cpu_index]
-#define HLTF    hltf[cpu_index]
+#define A       proc[cpu_index].a
+#define B       proc[cpu_index].b
+#define C       proc[cpu_index].c
+#define L       proc[cpu_index].l
+#define X       proc[cpu_index].x
+#define Y       proc[cpu_index].y
+#define Q       proc[cpu_index].q
+#define GH      proc[cpu_index].gh
+#define KV      proc[cpu_index].kv
+#define Ma      proc[cpu_index].ma
+#define S       proc[cpu_index].s
+#define F       proc[cpu_index].f
+#define R       proc[cpu_index].r
+#define P       proc[cpu_index].p
+#define T       proc[cpu_index].t
+#define AROF    proc[cpu_index].arof
+#define BROF    proc[cpu_index].brof
+#define PROF    proc[cpu_index].prof
+#define TROF    proc[cpu_index].trof
+#define NCSF    proc[cpu_index].ncsf
+#define SALF    proc[cpu_index].salf
+#define CWMF    proc[cpu_index].cwmf
+#define MSFF    proc[cpu_index].msff
+#define VARF    proc[cpu_index].varf
+#define HLTF    proc[cpu_index].hltf
 
 /* Definitions to help extract fields */
 #define FF(x)    (uint16)(((x) & FFIELD) >> FFIELD_V)
@@ -433,7 +490,8 @@ DEVICE              cpu_dev = {
 int memory_cycle(uint8 E) {
         uint16 addr = 0;
 
-        sim_interval--;
+        if (!cpu_thread)
+            sim_interval--;
         if (E & 2)
            addr = S;
         if (E & 4)
@@ -998,9 +1056,11 @@ void storeInterrupt(int forced, int test) {
         KV = 0;
         GH = 0;
     } else if (forced) {
-        if (cpu_index) {
+        if (cpu_thread) {
+           cpu_p2_halt();       /* Hand CPU 2 state back to CPU 1 */
+        } else if (cpu_index) {
            P2_run = 0;          /* Clear halt flag */
-           hltf[1] = 0;
+           proc[1].hltf = 0;
            cpu_index = 0;
         } else {
            T = WMOP_ITI;
@@ -1976,6 +2036,30 @@ void relativeAddr(int store) {
 
 t_stat
 sim_instr(void)
+{
+    t_stat              reason;
+
+    proc[0].hltf = 0;
+    proc[1].hltf = 0;
+    P1_run = 1;
+#if defined(SIM_ASYNCH_IO)
+    cpu_p2_reason = SCPE_OK;    /* Forget why CPU 2 stopped last time */
+#endif
+    if (cpu_parallel) {
+        cpu_index = 0;
+        if (P2_run)
+            cpu_p2_start();
+    }
+    reason = cpu_run();
+    if (cpu_parallel)
+        cpu_p2_pause();
+    return reason;
+}
+
+/* Execute instructions. In parallel mode this runs in both the main
+   thread, for CPU 1, and the CPU 2 thread. */
+t_stat
+cpu_run(void)
 {
     t_stat              reason;
     t_uint64            temp = 0LL;
@@ -1989,40 +2073,45 @@ sim_instr(void)
     int                 j;
 
     reason = SCPE_OK;
-    hltf[0] = 0;
-    hltf[1] = 0;
-    P1_run = 1;
 
     while (reason == 0) {       /* loop until halted */
-        if (P1_run == 0)
-            return SCPE_STOP;
-        /* System is booting, wait until finished loading */
-        while (loading) {
-            reason = sim_process_event();
-            if (reason != SCPE_OK)
-                 break; /* process */
-        }
-        /* Passed time quantum */
-        if (sim_interval <= 0) {        /* event queue? */
-            reason = sim_process_event();
-            if (reason != SCPE_OK)
-                 break; /* process */
+        if (cpu_thread) {
+            /* CPU 2 thread, events are left to the main thread */
+            if (P2_run == 0 || cpu_p2_stop)
+                break;
+        } else {
+            if (P1_run == 0)
+                return SCPE_STOP;
+            /* System is booting, wait until finished loading */
+            while (loading) {
+                reason = sim_process_event();
+                if (reason != SCPE_OK)
+                     break; /* process */
+            }
+            /* Passed time quantum */
+            if (sim_interval <= 0) {        /* event queue? */
+                reason = sim_process_event();
+                if (reason == SCPE_OK)
+                     reason = cpu_p2_reason;
+                if (reason != SCPE_OK)
+                     break; /* process */
+            }
         }
 
         if (sim_brk_summ) {
-            if(sim_brk_test((C << 3) | L, SWMASK('E'))) {
+            if(cpu_brk_test((C << 3) | L, SWMASK('E'))) {
                 reason = SCPE_STOP;
                 break;
             }
 
-            if (sim_brk_test((c_reg[0] << 3) | l_reg[0],
+            if (!cpu_thread && cpu_brk_test((proc[0].c << 3) | proc[0].l,
                          SWMASK('A'))) {
                 reason = SCPE_STOP;
                 break;
             }
 
-            if (sim_brk_test((c_reg[1] << 3) | l_reg[1],
-                         SWMASK('B'))) {
+            if ((cpu_thread || !cpu_parallel) &&
+                cpu_brk_test((proc[1].c << 3) | proc[1].l, SWMASK('B'))) {
                 reason = SCPE_STOP;
                 break;
             }
@@ -2034,7 +2123,10 @@ sim_instr(void)
                 storeInterrupt(1,0);
         }
 
-        if (cpu_index == 0 && P2_run == 1) {
+        if (cpu_thread) {
+            if (P2_run == 0)    /* Interrupted, CPU 1 takes over */
+                break;
+        } else if (cpu_index == 0 && P2_run == 1 && !cpu_parallel) {
             cpu_index = 1;
         } else {
             cpu_index = 0;
@@ -2046,8 +2138,10 @@ crf_loop:
         opcode = T & 077;
         field = (T >> 6) & 077;
         TROF = 0;
+        sim_profile (T, C);
 
         if (hst_lnt) {  /* history enabled? */
+            P2_LOCK();
             /* Ignore idle loop when recording history */
                 /* DCMCP XIII */
             /* if ((C & 077774) != 01140) { */
@@ -2081,6 +2175,7 @@ crf_loop:
                                ((SALF)? F_SALF : 0) | \
                                ((MSFF)? F_MSFF : 0) | \
                                ((VARF)? F_VARF : 0);
+            P2_UNLOCK();
              /* }  */
         }
 
@@ -3027,12 +3122,12 @@ control:
                         if (NCSF)       /* Nop in normal state */
                             break;
 
-                        if (q_reg[0] & MEM_PARITY) {
+                        if (proc[0].q & MEM_PARITY) {
                             C = PARITY_ERR;
-                            q_reg[0] &= ~MEM_PARITY;
-                        } else if (q_reg[0] & INVALID_ADDR) {
+                            proc[0].q &= ~MEM_PARITY;
+                        } else if (proc[0].q & INVALID_ADDR) {
                             C = INVADR_ERR;
-                            q_reg[0] &= ~INVALID_ADDR;
+                            proc[0].q &= ~INVALID_ADDR;
                         } else if (IAR) {
                             uint16  x;
                             C = INTER_TIME;
@@ -3042,31 +3137,31 @@ control:
                             if (C >= IO1_FINISH && C <= IO4_FINISH)
                                 chan_release(C - IO1_FINISH);
                             IAR &= ~x;
-                        } else if ((q_reg[0] & 0170) != 0) {
-                            C = 060 + (q_reg[0] >> 3);
-                            q_reg[0] &= 07;
-                        } else if (q_reg[0] & STK_OVERFL) {
+                        } else if ((proc[0].q & 0170) != 0) {
+                            C = 060 + (proc[0].q >> 3);
+                            proc[0].q &= 07;
+                        } else if (proc[0].q & STK_OVERFL) {
                             C = STK_OVR_LOC;
-                            q_reg[0] &= ~STK_OVERFL;
-                        } else if (P2_run == 0 && q_reg[1] != 0) {
-                            if (q_reg[1] & MEM_PARITY) {
+                            proc[0].q &= ~STK_OVERFL;
+                        } else if (proc[1].q != 0 && cpu_p2_halted()) {
+                            if (proc[1].q & MEM_PARITY) {
                                 C = PARITY_ERR2;
-                                q_reg[1] &= ~MEM_PARITY;
-                            } else if (q_reg[1] & INVALID_ADDR) {
+                                proc[1].q &= ~MEM_PARITY;
+                            } else if (proc[1].q & INVALID_ADDR) {
                                 C = INVADR_ERR2;
-                                q_reg[1] &= ~INVALID_ADDR;
-                            } else if ((q_reg[1] & 0170) != 0) {
-                                C = 040 + (q_reg[1] >> 3);
-                                q_reg[1] &= 07;
-                            } else if (q_reg[1] & STK_OVERFL) {
+                                proc[1].q &= ~INVALID_ADDR;
+                            } else if ((proc[1].q & 0170) != 0) {
+                                C = 040 + (proc[1].q >> 3);
+                                proc[1].q &= 07;
+                            } else if (proc[1].q & STK_OVERFL) {
                                 C = STK_OVR_LOC2;
-                                q_reg[1] &= ~STK_OVERFL;
+                                proc[1].q &= ~STK_OVERFL;
                             }
                         } else {
                              /* Could be an idle loop, if P2 running, continue */
                              if (P2_run)
                                  break;
-                             if (sim_idle_enab) {
+                             if (sim_idle_enab || sim_fastio_enab) {
                              /* Check if possible idle loop */
                                  if (check_idle())
                                     sim_idle (TMR_RTC, FALSE);
@@ -3137,7 +3232,7 @@ control:
                            break;
                         if (!HALT)
                            break;
-                        hltf[0] = 1;
+                        proc[0].hltf = 1;
                         P1_run = 0;
                         break;
 
@@ -3146,13 +3241,23 @@ control:
                         if (NCSF)
                            break;
                         /* If CPU 2 is not running, or disabled nop */
+                        P2_LOCK();
                         if (P2_run == 0 || (cpu_unit[1].flags & UNIT_DIS)) {
+                            P2_UNLOCK();
                             break;
                         }
                         sim_debug(DEBUG_DETAIL, &cpu_dev, "HALT P2\n\r");
                         /* Flag P2 to stop */
-                        hltf[1] = 1;
+                        proc[1].hltf = 1;
+                        P2_UNLOCK();
                         TROF = 1;       /* Reissue until CPU2 stopped */
+                        /* No memory cycle here, so count down the time
+                           quantum to let events in. If the CPU 2 thread
+                           stopped it won't halt, so stop CPU 1 now. */
+                        if (cpu_p2_reason != SCPE_OK || stop_cpu)
+                            sim_interval = 0;
+                        else
+                            sim_interval--;
                         break;
 
                 case VARIANT(WMOP_IP1): /* Initiate P1 */
@@ -3175,13 +3280,19 @@ control:
                         }
                         /* Ok we are going to initiate B.
                            load the initiate word from 010. */
-                        hltf[1] = 0;
+                        if (cpu_parallel)
+                            cpu_p2_wait();
+                        proc[1].hltf = 0;
                         P2_run = 1;
                         cpu_index = 1;  /* To CPU 2 */
                         Ma = 010;
                         memory_cycle(4);
                         sim_debug(DEBUG_DETAIL, &cpu_dev, "INIT P2\n\r");
                         initiate();
+                        if (cpu_parallel) {
+                            cpu_index = 0;
+                            cpu_p2_start();
+                        }
                         break;
 
                 case VARIANT(WMOP_IIO): /* Initiate I/O */
@@ -3641,7 +3752,7 @@ control:
                         do {
                             Ma = CF(B);
                             memory_cycle(5);
-                            if (sim_interval <= 0) {        /* event queue? */
+                            if (!cpu_thread && sim_interval <= 0) {
                                 reason = sim_process_event();
                                 if (reason != SCPE_OK) {
                                      break; /* process */
@@ -3794,6 +3905,115 @@ control:
 
     return reason;
 }
+
+/* Breakpoint test, the breakpoint table is shared by both threads */
+int
+cpu_brk_test(t_addr loc, uint32 type)
+{
+    int     r;
+
+    P2_LOCK();
+    r = sim_brk_test(loc, type);
+    P2_UNLOCK();
+    return r;
+}
+
+#if defined(SIM_ASYNCH_IO)
+/* CPU 2 host thread, runs CPU 2 each time it is started */
+static void *
+cpu_p2_thread(void *arg)
+{
+    t_stat              r;
+
+    cpu_thread = 1;
+    pthread_mutex_lock(&cpu_p2_lock);
+    while (1) {
+        while (!cpu_p2_go)
+            pthread_cond_wait(&cpu_p2_cond, &cpu_p2_lock);
+        cpu_p2_go = 0;
+        cpu_p2_busy = 1;
+        pthread_mutex_unlock(&cpu_p2_lock);
+        cpu_index = 1;
+        r = cpu_run();
+        pthread_mutex_lock(&cpu_p2_lock);
+        if (r != SCPE_OK)
+            cpu_p2_reason = r;
+        cpu_p2_busy = 0;
+        pthread_cond_broadcast(&cpu_p2_done);
+    }
+    return NULL;
+}
+#endif
+
+/* Let CPU 2 thread run */
+void
+cpu_p2_start()
+{
+#if defined(SIM_ASYNCH_IO)
+    pthread_mutex_lock(&cpu_p2_lock);
+    if (!cpu_p2_tcreated) {
+        if (pthread_create(&cpu_p2_tid, NULL, &cpu_p2_thread, NULL) != 0) {
+            pthread_mutex_unlock(&cpu_p2_lock);
+            cpu_p2_reason = SCPE_IERR;
+            return;
+        }
+        cpu_p2_tcreated = 1;
+    }
+    cpu_p2_stop = 0;
+    cpu_p2_go = 1;
+    pthread_cond_signal(&cpu_p2_cond);
+    pthread_mutex_unlock(&cpu_p2_lock);
+#endif
+}
+
+/* Stop CPU 2 thread at an instruction boundary and wait for it */
+void
+cpu_p2_pause()
+{
+#if defined(SIM_ASYNCH_IO)
+    pthread_mutex_lock(&cpu_p2_lock);
+    cpu_p2_stop = 1;
+    cpu_p2_go = 0;
+    while (cpu_p2_busy)
+        pthread_cond_wait(&cpu_p2_done, &cpu_p2_lock);
+    pthread_mutex_unlock(&cpu_p2_lock);
+#endif
+}
+
+/* Wait for CPU 2 thread to finish halting */
+void
+cpu_p2_wait()
+{
+#if defined(SIM_ASYNCH_IO)
+    pthread_mutex_lock(&cpu_p2_lock);
+    while (cpu_p2_busy)
+        pthread_cond_wait(&cpu_p2_done, &cpu_p2_lock);
+    pthread_mutex_unlock(&cpu_p2_lock);
+#endif
+}
+
+/* CPU 2 thread took an interrupt. Under the lock so that CPU 1
+   sees the stored state before P2_run clears. */
+void
+cpu_p2_halt()
+{
+    P2_LOCK();
+    proc[1].hltf = 0;
+    P2_run = 0;
+    P2_UNLOCK();
+}
+
+/* Check if CPU 2 has halted, from CPU 1 */
+int
+cpu_p2_halted()
+{
+    int     r;
+
+    P2_LOCK();
+    r = (P2_run == 0);
+    P2_UNLOCK();
+    return r;
+}
 
 /* Interval timer routines */
 t_stat
@@ -3824,7 +4044,7 @@ cpu_reset(DEVICE * dptr)
     A = B = X = P = 0;
     AROF = BROF = TROF = PROF = NCSF = SALF = CWMF = MSFF = VARF = 0;
     GH = KV = Q = 0;
-    hltf[1] = 0;
+    proc[1].hltf = 0;
     P2_run = 0;
     /* Reset CPU 1 now */
     cpu_index = 0;
@@ -3834,7 +4054,7 @@ cpu_reset(DEVICE * dptr)
     A = B = X = P = 0;
     AROF = BROF = TROF = PROF = NCSF = SALF = CWMF = MSFF = VARF = 0;
     GH = KV = Q = 0;
-    hltf[0] = 0;
+    proc[0].hltf = 0;
     P1_run = 0;
     IAR = 0;
     HALT = 0;
@@ -3850,6 +4070,17 @@ cpu_reset(DEVICE * dptr)
 }
 
 
+/* Select interleaved or parallel execution of CPU 2 */
+t_stat
+cpu_set_par(UNIT * uptr, int32 val, CONST char *cptr, void *desc)
+{
+#if defined(SIM_ASYNCH_IO)
+    return SCPE_OK;
+#else
+    return (val) ? SCPE_NOFNC : SCPE_OK;
+#endif
+}
+
 /* Memory examine */
 
 t_stat
@@ -4025,6 +4256,10 @@ t_stat              cpu_help(FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, con
     fprintf(st, "       sim> SET CPU1 ENABLE                enable second CPU\n");
     fprintf(st, "The primary CPU can't be disabled. Memory is shared between the two\n");
     fprintf(st, "CPU's. Memory can be configured in 4K increments up to 32K total.\n");
+    fprintf(st, "By default the two CPU's are interleaved one instruction at a time.\n");
+    fprintf(st, "       sim> SET CPU PARALLEL               run CPU 2 on its own thread\n");
+    fprintf(st, "runs CPU 2 on a separate host thread over the shared memory. CPU 1 and\n");
+    fprintf(st, "all I/O stay on the main thread.\n");
     fprint_reg_help (st, dptr);
     fprint_set_help(st, dptr);
     fprint_show_help(st, dptr);
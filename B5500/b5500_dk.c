@@ -319,6 +319,7 @@ t_stat esu_srv(UNIT * uptr)
     int                 u = uptr - esu_unit;
     int                 dsk = ((uptr->CMD & DK_CTRL) != 0);
     int                 wc;
+    uint8               *map;
     
  
     /* Process for each unit */
@@ -344,12 +345,18 @@ t_stat esu_srv(UNIT * uptr)
             sim_debug(DEBUG_DETAIL, dptr, "Disk read %d %d %d %o %d\n\r",
                                  u,uptr->POS, uptr->ADDR, uptr->CMD, da);
         
-            if (sim_fseek(uptr->fileref, da, SEEK_SET) < 0) {
-                esu_set_end(uptr, 1);
-                return SCPE_OK;
+            if ((map = sim_fmap_ptr(uptr, da, DK_SEC_SIZE)) != NULL) {
+                /* Mapped image, no file I/O */
+                memcpy(&dsk_buffer[dsk][0], map, DK_SEC_SIZE);
+                wc = DK_SEC_SIZE;
+            } else {
+                if (sim_fseek(uptr->fileref, da, SEEK_SET) < 0) {
+                    esu_set_end(uptr, 1);
+                    return SCPE_OK;
+                }
+                wc = sim_fread(&dsk_buffer[dsk][0], 1, DK_SEC_SIZE,
+                                     uptr->fileref);
             }
-            wc = sim_fread(&dsk_buffer[dsk][0], 1, DK_SEC_SIZE,
-                                 uptr->fileref);
             for (; wc < DK_SEC_SIZE; wc++) 
                 dsk_buffer[dsk][wc] = (uptr->CMD & DK_BIN) ? 0 :020;
             uptr->POS = 0;
@@ -425,16 +432,22 @@ t_stat esu_srv(UNIT * uptr)
         
            sim_debug(DEBUG_DETAIL, dptr, "Disk write %d %d %d %o %d\n\r",
                             u, uptr->POS, uptr->ADDR, uptr->CMD, da);
-           if (sim_fseek(uptr->fileref, da, SEEK_SET) < 0) {
-               esu_set_end(uptr, 1);
-               return SCPE_OK;
-           }
+           if ((map = sim_fmap_ptr(uptr, da, DK_SEC_SIZE)) != NULL) {
+               /* Mapped image, store straight into it */
+               memcpy(map, &dsk_buffer[dsk][0], DK_SEC_SIZE);
+               sim_fmap_dirty(uptr);
+           } else {
+               if (sim_fseek(uptr->fileref, da, SEEK_SET) < 0) {
+                   esu_set_end(uptr, 1);
+                   return SCPE_OK;
+               }
         
-           wc = sim_fwrite(&dsk_buffer[dsk][0], 1, DK_SEC_SIZE, 
-                                   uptr->fileref);
-           if (wc != DK_SEC_SIZE) {
-               esu_set_end(uptr, 1);
-               return SCPE_OK;
+               wc = sim_fwrite(&dsk_buffer[dsk][0], 1, DK_SEC_SIZE, 
+                                       uptr->fileref);
+               if (wc != DK_SEC_SIZE) {
+                   esu_set_end(uptr, 1);
+                   return SCPE_OK;
+               }
            }
            uptr->POS = 0;
            uptr->ADDR++;  /* Advance disk address */
@@ -493,7 +506,8 @@ esu_attach(UNIT * uptr, CONST char *file)
     if (u >= 10 || (dsk_unit[1].flags & DFX) != 0) {
         iostatus |= DSK2_FLAG;
     }
-    return SCPE_OK;
+    /* ATTACH -M maps the whole unit */
+    return sim_fmap_attach(uptr, (t_offset)uptr->capac);
 }
 
 t_stat
@@ -578,6 +592,9 @@ esu_help (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, const char *cptr)
   fprintf (st, "     sim> SET ESUn MODIB       before the unit is attached\n");
   fprintf (st, "To use smaller faster drives do (default):\n");
   fprintf (st, "     sim> SET ESUn MODI        before the unit is attached\n\n");
+  fprintf (st, "ATTACH -M maps the whole disk file into memory, so segments are\n");
+  fprintf (st, "transferred without file I/O. Changes are written back on detach\n");
+  fprintf (st, "or SAVE.\n\n");
   fprint_set_help (st, dptr) ;
   fprint_show_help (st, dptr) ;
   return SCPE_OK;
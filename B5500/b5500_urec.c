@@ -741,8 +741,7 @@ print_line(UNIT * uptr, int unit)
         out[++i] = '\0';
 
         /* Print out buffer */
-        sim_fwrite(&out, 1, i, uptr->fileref);
-        uptr->pos += i;
+        sim_spool_write(uptr, &out, i);
         uptr->CMD &= ~URCSTA_EOF;
     }
 
@@ -758,18 +757,14 @@ print_line(UNIT * uptr, int unit)
 
     case 3:     /* Even lines */
         if ((uptr->LINENUM & 1) == 1) {
-            sim_fwrite("\r", 1, 1, uptr->fileref);
-            sim_fwrite("\n", 1, 1, uptr->fileref);
-            uptr->pos += 2;
+            sim_spool_write(uptr, "\r\n", 2);
             uptr->LINENUM++;
             uptr->CMD &= ~URCSTA_EOF;
         }
         break;
     case 4:     /* Odd lines */
         if ((uptr->LINENUM & 1) == 0) {
-            sim_fwrite("\r", 1, 1, uptr->fileref);
-            sim_fwrite("\n", 1, 1, uptr->fileref);
-            uptr->pos += 2;
+            sim_spool_write(uptr, "\r\n", 2);
             uptr->LINENUM++;
             uptr->CMD &= ~URCSTA_EOF;
         }
@@ -777,9 +772,7 @@ print_line(UNIT * uptr, int unit)
     case 5:     /* Half page */
         while((uptr->LINENUM != (uptr->capac/2)) ||
               (uptr->LINENUM != (uptr->capac))) {
-            sim_fwrite("\r", 1, 1, uptr->fileref);
-            sim_fwrite("\n", 1, 1, uptr->fileref);
-            uptr->pos += 2;
+            sim_spool_write(uptr, "\r\n", 2);
             uptr->LINENUM++;
             if (((uint32)uptr->LINENUM) > uptr->capac) {
                 uptr->LINENUM = 1;
@@ -793,9 +786,7 @@ print_line(UNIT * uptr, int unit)
               (uptr->LINENUM != (uptr->capac/2)) ||
               (uptr->LINENUM != (uptr->capac/2+uptr->capac/4)) ||
               (uptr->LINENUM != (uptr->capac))) {
-            sim_fwrite("\r", 1, 1, uptr->fileref);
-            sim_fwrite("\n", 1, 1, uptr->fileref);
-            uptr->pos += 2;
+            sim_spool_write(uptr, "\r\n", 2);
             uptr->LINENUM++;
             if (((uint32)uptr->LINENUM) > uptr->capac) {
                 uptr->LINENUM = 1;
@@ -809,9 +800,7 @@ print_line(UNIT * uptr, int unit)
     case 9:
     case 10:
     case 11:
-        sim_fwrite("\r", 1, 1, uptr->fileref);
-        sim_fwrite("\n", 1, 1, uptr->fileref);
-        uptr->pos += 2;
+        sim_spool_write(uptr, "\r\n", 2);
         uptr->LINENUM++;
         break;
     }
@@ -820,9 +809,8 @@ print_line(UNIT * uptr, int unit)
     if (((uint32)uptr->LINENUM) > uptr->capac) {
         uptr->LINENUM = 1;
         uptr->CMD |= URCSTA_EOF;
-        sim_fwrite("\f", 1, 1, uptr->fileref);
-        uptr->pos ++;
-        sim_fseek(uptr->fileref, 0, SEEK_CUR);
+        sim_spool_write(uptr, "\f", 1);
+        sim_spool_flush(uptr);
         sim_debug(DEBUG_DETAIL, &lpr_dev, "lpr %d page\n", unit);
     }
 
@@ -914,7 +902,7 @@ lpr_attach(UNIT * uptr, CONST char *file)
         uptr->POS = 0;
     }
     iostatus |= PRT1_FLAG << u;
-    return SCPE_OK;
+    return sim_spool_attach(uptr);
 }
 
 t_stat
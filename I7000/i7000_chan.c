@@ -32,6 +32,7 @@ extern DEVICE      *sim_devices[];
 
 
 int     num_devs[NUM_CHAN];
+uint32  chan_work;                      /* Bit per channel with work pending */
 
 
 t_stat
@@ -423,6 +424,7 @@ int chan_stat(int chan, uint32 flag)
 {
     if (chan_flags[chan] & flag) {
         chan_flags[chan] &= ~flag;
+        CHAN_WAKE(chan);
         return 1;
     }
     return 0;
@@ -453,18 +455,21 @@ void
 chan_set_attn(int chan)
 {
     chan_flags[chan] |= CHS_ATTN;
+    CHAN_WAKE(chan);
 }
 
 void
 chan_set_eof(int chan)
 {
     chan_flags[chan] |= CHS_EOF;
+    CHAN_WAKE(chan);
 }
 
 void
 chan_set_error(int chan)
 {
     chan_flags[chan] |= CHS_ERR;
+    CHAN_WAKE(chan);
 }
 
 void
@@ -475,6 +480,7 @@ chan_set_sel(int chan, int need)
     chan_flags[chan] |= DEV_SEL;
     if (need)
         chan_flags[chan] |= DEV_WRITE;
+    CHAN_WAKE(chan);
 }
 
 void
@@ -482,23 +488,27 @@ chan_clear_status(int chan)
 {
     chan_flags[chan] &=
         ~(CHS_ATTN | CHS_EOT | CHS_BOT | DEV_REOR | DEV_WEOR);
+    CHAN_WAKE(chan);
 }
 
 void
 chan_set(int chan, uint32 flag)
 {
     chan_flags[chan] |= flag;
+    CHAN_WAKE(chan);
 }
 
 void
 chan_clear(int chan, uint32 flag)
 {
     chan_flags[chan] &= ~flag;
+    CHAN_WAKE(chan);
 }
 
 void
 chan9_clear_error(int chan, int sel) {
     chan_flags[chan] &= ~(SNS_UEND | (SNS_ATTN1 >> sel));
+    CHAN_WAKE(chan);
 }
 
 void
@@ -273,6 +273,10 @@ extern DEBTAB crd_debug[];
 /* Channel half of controls */
 /* Channel status */
 extern uint32   chan_flags[NUM_CHAN];           /* Channel flags */
+extern uint32   chan_work;                      /* Channels chan_proc visits */
+/* Flag channel as needing chan_proc, done on every change of channel state */
+#define CHAN_WAKE(chan)  (chan_work |= 1 << (chan))
+#define CHAN_WAKE_ALL()  (chan_work = (1 << NUM_CHAN) - 1)
 extern const char *chname[11];                  /* Channel names */
 extern int      num_devs[NUM_CHAN];             /* Number devices per channel*/
 extern uint8    lpr_chan9[NUM_CHAN];
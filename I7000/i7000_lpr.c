@@ -221,8 +221,7 @@ print_line(UNIT * uptr, int chan, int unit)
 
     /* Print out buffer */
     if (uptr->flags & UNIT_ATT) {
-        sim_fwrite(&out, 1, i, uptr->fileref);
-        uptr->pos += i;
+        sim_spool_write(uptr, &out, i);
     }
     if (uptr->flags & ECHO) {
         int                 j = 0;
@@ -239,16 +238,14 @@ print_line(UNIT * uptr, int chan, int unit)
         i = (uptr->u5 >> 12) & 0x7f;
         if (i == 0) {
             if (uptr->flags & UNIT_ATT) {
-                sim_fwrite("\r\n", 1, 2, uptr->fileref);
-                uptr->pos += 2;
+                sim_spool_write(uptr, "\r\n", 2);
             }
             if (uptr->flags & ECHO)
                 sim_putchar('\r');
         } else {
             for (; i > 1; i--) {
                 if (uptr->flags & UNIT_ATT) {
-                    sim_fwrite("\r\n", 1, 2, uptr->fileref);
-                    uptr->pos += 2;
+                    sim_spool_write(uptr, "\r\n", 2);
                 }
                 if (uptr->flags & ECHO) {
                     sim_putchar('\r');
@@ -338,8 +335,7 @@ uint32 lpr_cmd(UNIT * uptr, uint16 cmd, uint16 dev)
         case 040: /* Space before */
              for (i = dev & 03; i > 1; i--) {
                 if (uptr->flags & UNIT_ATT) {
-                    sim_fwrite("\r\n", 1, 2, uptr->fileref);
-                    uptr->pos += 2;
+                    sim_spool_write(uptr, "\r\n", 2);
                 }
                 if (uptr->flags & ECHO) {
                     sim_putchar('\r');
@@ -367,8 +363,7 @@ uint32 lpr_cmd(UNIT * uptr, uint16 cmd, uint16 dev)
              }
              for (; i > 0; i--) {
                 if (uptr->flags & UNIT_ATT) {
-                    sim_fwrite("\r\n", 1, 2, uptr->fileref);
-                    uptr->pos += 2;
+                    sim_spool_write(uptr, "\r\n", 2);
                 }
                 if (uptr->flags & ECHO) {
                     sim_putchar('\r');
@@ -480,7 +475,7 @@ lpr_attach(UNIT * uptr, CONST char *file)
         return r;
     uptr->u5 = 0;
     uptr->u4 = 0;
-    return SCPE_OK;
+    return sim_spool_attach(uptr);
 }
 
 t_stat
@@ -206,6 +206,7 @@ chan_reset(DEVICE * dptr)
         cmd[i] = 0;
         bcnt[i] = 0;
     }
+    CHAN_WAKE_ALL();
     return chan_set_devs(dptr);
 }
 
@@ -229,6 +230,7 @@ chan_boot(int32 unit_num, DEVICE * dptr)
     cmd[chan] = CHAN_NOREC|CHAN_LOAD;
     chunit[chan] = unit_num;
     chan_flags[chan] |= STA_ACTIVE;
+    CHAN_WAKE(chan);
     return SCPE_OK;
 }
 
@@ -280,6 +282,28 @@ chan_issue_cmd(uint16 chan, uint16 dcmd, uint16 dev) {
     return SCPE_NODEV;
 }
 
+/* Check if chan_proc has nothing to do on channel until the CPU or
+   a device changes its state. */
+static int
+chan_idle(int chan)
+{
+    uint32              flags = chan_flags[chan];
+
+    if (chan_unit[chan].flags & UNIT_DIS || flags & DEV_DISCO)
+        return 1;
+    if (flags & (CHS_EOF|CHS_ERR|CHS_ATTN|DEV_REOR))
+        return 0;
+    /* Waiting for disk seek to finish */
+    if (cmd[chan] & CHAN_DSK_SEEK)
+        return chan_seek_done[chan] == 0 && (flags & SNS_UEND) == 0;
+    if (flags & (CTL_READ|CTL_WRITE) && flags & (CTL_END|SNS_UEND))
+        return 0;
+    /* Active with nothing left to do gets cleared */
+    return (flags & (DEV_SEL|STA_ACTIVE)) != STA_ACTIVE ||
+           (flags & (CTL_CNTL|CTL_PREAD|CTL_PWRITE|CTL_READ|CTL_WRITE
+                        |CTL_SNS)) != 0;
+}
+
 /* Execute the next channel instruction. */
 void
 chan_proc()
@@ -290,14 +314,17 @@ chan_proc()
     /* Scan channels looking for work */
     for (chan = 0; chan < NUM_CHAN; chan++) {
 
-        /* Skip if channel is disabled */
-        if (chan_unit[chan].flags & UNIT_DIS)
+        /* Skip channel if nothing changed since it went idle */
+        if ((chan_work & (1 << chan)) == 0)
+            continue;
+
+        /* Skip if channel is disabled, disconnecting or has nothing to do */
+        if (chan_idle(chan)) {
+            chan_work &= ~(1 << chan);
             continue;
+        }
 
         cmask = 0x0100 << chan;
-       /* If channel is disconnecting, do nothing */
-        if (chan_flags[chan] & DEV_DISCO)
-             continue;
 
         if (chan_flags[chan] & CHS_EOF) {
              chan_io_status[chan] |= IO_CHS_COND;
@@ -461,6 +488,7 @@ chan_cmd(uint16 dev, uint16 dcmd, uint32 addr)
     if (chan_flags[chan] & (DEV_SEL|DEV_DISCO|STA_TWAIT|STA_WAIT|STA_ACTIVE))
         return SCPE_BUSY;
     /* Ok, try and find the unit */
+    CHAN_WAKE(chan);
     caddr[chan] = addr;
     assembly[chan] = 0;
     cmd[chan] = 0;
@@ -560,6 +588,8 @@ chan_write_char(int chan, uint8 * data, int flags)
 {
     uint8       ch = *data;
 
+    CHAN_WAKE(chan);
+
     sim_debug(DEBUG_DATA, &chan_dev, "chan %d char %o %d %o %o\n", chan,
                *data, caddr[chan], chan_io_status[chan], flags);
 
@@ -629,6 +659,7 @@ chan_write_char(int chan, uint8 * data, int flags)
 int
 chan_read_char(int chan, uint8 * data, int flags)
 {
+    CHAN_WAKE(chan);
 
     /* Return END_RECORD if requested */
     if (flags & DEV_WEOR) {
@@ -701,6 +732,7 @@ chan_read_char(int chan, uint8 * data, int flags)
 void
 chan9_set_error(int chan, uint32 mask)
 {
+    CHAN_WAKE(chan);
     if (chan_flags[chan] & mask)
         return;
     chan_flags[chan] |= mask;
@@ -230,6 +230,9 @@ MTAB                cpu_mod[] = {
           "No memory protection"},
     {OPTION_PROT, OPTION_PROT, "PROT", "PROT", NULL, NULL, NULL,
           "Memory Protection"},
+    {MTAB_XTD|MTAB_VDV|MTAB_VALO|MTAB_NMO, 1, "PROFILE", "PROFILE",
+       &sim_set_profile, &sim_show_profile, NULL, "Enable instruction profile, PROFILE=RESET clears counts"},
+    {MTAB_XTD|MTAB_VDV, 0, NULL, "NOPROFILE", &sim_set_profile, NULL, NULL, "Disable instruction profile"},
     {MTAB_XTD | MTAB_VDV | MTAB_NMO | MTAB_SHP, 0, "HISTORY", "HISTORY",
      &cpu_set_hist, &cpu_show_hist},
     {0}
@@ -582,12 +585,14 @@ sim_instr(void)
 
     reason = 0;
     fault = 0;
+    CHAN_WAKE_ALL();            /* Channel state may have been changed */
     if (cpu_unit.flags & OPTION_PROT)
         sim_activate(&cpu_unit, sim_rtcn_calb(cpu_unit.wait, TMR_RTC));
 
     while (reason == 0) {       /* loop until halted */
 
-        chan_proc();
+        if (chan_work)
+            chan_proc();
         if (chwait != 0) {
             if (chan_active(chwait & 07)) {
                 sim_interval = 0;
@@ -636,6 +641,7 @@ sim_instr(void)
                 goto check_prot;
             }
             op &= 077;
+            sim_profile (op, IAR - 1);
             op_info = (CPU_MODEL != 1)? op_args[op]: op_1401[op];
             state = 1;
             i = 1;
@@ -173,6 +173,9 @@ REG                 cpu_reg[] = {
 };
 
 MTAB                cpu_mod[] = {
+    {MTAB_XTD|MTAB_VDV|MTAB_VALO|MTAB_NMO, 1, "PROFILE", "PROFILE",
+       &sim_set_profile, &sim_show_profile, NULL, "Enable instruction profile, PROFILE=RESET clears counts"},
+    {MTAB_XTD|MTAB_VDV, 0, NULL, "NOPROFILE", &sim_set_profile, NULL, NULL, "Disable instruction profile"},
     {MTAB_XTD | MTAB_VDV | MTAB_NMO | MTAB_SHP, 0, "HISTORY", "HISTORY",
      &cpu_set_hist, &cpu_show_hist},
     {0}
@@ -257,6 +260,7 @@ sim_instr(void)
         }
         ihold = 0;
         opcode = ((uint16)(temp >> 12L)) & 077;
+        sim_profile (opcode, IC);
         MA = (uint16)(temp & AMASK);
         ibr = SR = ReadP(MA>>1);
         if ((opcode & 040) == 0) {
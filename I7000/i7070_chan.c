@@ -234,6 +234,7 @@ chan_reset(DEVICE * dptr)
         limit[i] = 0;
         location[i] = 0;
     }
+    CHAN_WAKE_ALL();
     return chan_set_devs(dptr);
 }
 
@@ -294,6 +295,35 @@ chan_issue_cmd(uint16 chan, uint16 dcmd, uint16 dev) {
     return SCPE_NODEV;
 }
 
+/* Check if chan_proc has nothing to do on channel until the CPU or
+   a device changes its state. */
+static int
+chan_idle(int chan)
+{
+    uint32              flags = chan_flags[chan];
+
+    if (chan_unit[chan].flags & UNIT_DIS || flags & DEV_DISCO)
+        return 1;
+    /* Channel stop pending */
+    if ((flags & (DEV_SEL|STA_TWAIT)) == STA_TWAIT)
+        return 0;
+    switch (CHAN_G_TYPE(chan_unit[chan].flags)) {
+    case CHAN_UREC:
+    case CHAN_7604:
+        if (flags & (CHS_ATTN|STA_ACTIVE|STA_WAIT))
+            return 0;
+        /* Priority request polls the device */
+        return (cmd[chan] & CHN_SEGMENT) != 0 ||
+               (chan_info[chan] & CHAN_PRIO) == 0;
+    case CHAN_7907:
+        if (flags & STA_ACTIVE)
+            return 0;
+        return (flags & (DEV_SEL|STA_TWAIT)) != 0 ||
+               (flags & (SNS_ATTN1|SNS_ATTN2)) == 0;
+    }
+    return 1;
+}
+
 /* Execute the next channel instruction. */
 void
 chan_proc()
@@ -303,10 +333,16 @@ chan_proc()
 
     /* Scan channels looking for work */
     for (chan = 0; chan < NUM_CHAN; chan++) {
-        /* Skip if channel is disabled */
-        if (chan_unit[chan].flags & UNIT_DIS)
+        /* Skip channel if nothing changed since it went idle */
+        if ((chan_work & (1 << chan)) == 0)
             continue;
 
+        /* Skip if channel is disabled, disconnecting or has nothing to do */
+        if (chan_idle(chan)) {
+            chan_work &= ~(1 << chan);
+            continue;
+        }
+
         cmask = 0x0100 << chan;
         switch (CHAN_G_TYPE(chan_unit[chan].flags)) {
         case CHAN_UREC:
@@ -1227,6 +1263,7 @@ chan_cmd(uint16 dev, uint16 dcmd, uint16 addr)
     if (chan_flags[chan] & (DEV_SEL|DEV_DISCO|STA_TWAIT|STA_WAIT|STA_ACTIVE))
         return SCPE_BUSY;
     /* Ok, try and find the unit */
+    CHAN_WAKE(chan);
     prio = (dev & 0x1000)? 1: 0;
     dev &= 0xff;
     location[chan] = addr;
@@ -1299,6 +1336,9 @@ int
 chan_write_char(int chan, uint8 * data, int flags)
 {
     uint8       ch = *data;
+
+    CHAN_WAKE(chan);
+
     /* Check if last data still not taken */
     if (chan_flags[chan] & DEV_FULL) {
         /* Nope, see if we are waiting for end of record. */
@@ -1441,6 +1481,9 @@ int
 chan_read_char(int chan, uint8 * data, int flags)
 {
     uint8       ch;
+
+    CHAN_WAKE(chan);
+
     /* Return END_RECORD if requested */
     if (flags & DEV_WEOR) {
         chan_flags[chan] &= ~(DEV_WEOR /*| STA_WAIT*/);
@@ -1569,6 +1612,7 @@ chan_set_load_mode(int chan)
 void
 chan9_set_error(int chan, uint32 mask)
 {
+    CHAN_WAKE(chan);
     if (chan_flags[chan] & mask)
         return;
     chan_flags[chan] |= mask;
@@ -174,6 +174,9 @@ MTAB                cpu_mod[] = {
     {OPTION_EXTEND, OPTION_EXTEND, "EXTEND", "EXTEND", NULL, NULL, NULL},
     {OPTION_TIMER, 0, NULL, "NOCLOCK", NULL, NULL, NULL},
     {OPTION_TIMER, OPTION_TIMER, "CLOCK", "CLOCK", NULL, NULL, NULL},
+    {MTAB_XTD|MTAB_VDV|MTAB_VALO|MTAB_NMO, 1, "PROFILE", "PROFILE",
+       &sim_set_profile, &sim_show_profile, NULL, "Enable instruction profile, PROFILE=RESET clears counts"},
+    {MTAB_XTD|MTAB_VDV, 0, NULL, "NOPROFILE", &sim_set_profile, NULL, NULL, "Disable instruction profile"},
     {MTAB_XTD | MTAB_VDV | MTAB_NMO | MTAB_SHP, 0, "HISTORY", "HISTORY",
      &cpu_set_hist, &cpu_show_hist},
     {0}
@@ -299,6 +302,7 @@ sim_instr(void)
     }
 
     reason = 0;
+    CHAN_WAKE_ALL();            /* Channel state may have been changed */
 
     iowait = 0;
     stopnext = 0;
@@ -386,6 +390,7 @@ sim_instr(void)
                 op2 = (opcode >> 4) & 0xf;
                 if ((MBR & (SMASK >> 32)) == (MSIGN >> 32))
                     opcode |= 0x100;
+                sim_profile (opcode, IC - 1);
             /* Check if extended addressing mode */
                 if (emode && IX < 10) {
                     MA += dscale[3][IX];
@@ -2420,7 +2425,8 @@ sim_instr(void)
 
 
         }
-        chan_proc();            /* process any pending channel events */
+        if (chan_work)
+            chan_proc();        /* process any pending channel events */
         if (instr_count != 0 && --instr_count == 0)
             return SCPE_STEP;
     }                           /* end while */
@@ -195,6 +195,7 @@ chan_reset(DEVICE * dptr)
         cmd[i] = 0;
         bcnt[i] = 0;
     }
+    CHAN_WAKE_ALL();
     return chan_set_devs(dptr);
 }
 
@@ -248,6 +249,7 @@ chan_boot(int32 unit_num, DEVICE * dptr)
     chwait = chan + 1;  /* Force wait for channel */
     chan_flags[chan] |= STA_ACTIVE;
     chan_flags[chan] &= ~STA_PEND;
+    CHAN_WAKE(chan);
     cmd[chan] = 0;
     caddr[chan] = 0;
     return SCPE_OK;
@@ -391,13 +393,18 @@ chan_proc()
 
     /* Scan channels looking for work */
     for (chan = 0; chan < NUM_CHAN; chan++) {
-        /* Skip if channel is disabled */
-        if (chan_unit[chan].flags & UNIT_DIS)
+        /* Skip channel if nothing changed since it went idle */
+        if ((chan_work & (1 << chan)) == 0)
             continue;
 
-       /* If channel is disconnecting, do nothing */
-        if (chan_flags[chan] & DEV_DISCO)
-             continue;
+        /* Skip if channel is disabled, disconnecting or not in use. Only
+           a CPU or device request can make it do anything again. */
+        if (chan_unit[chan].flags & UNIT_DIS ||
+            chan_flags[chan] & DEV_DISCO ||
+            (chan_flags[chan] & (STA_PEND|STA_ACTIVE)) == 0) {
+            chan_work &= ~(1 << chan);
+            continue;
+        }
         cmask = 0x0100 << chan;
 
         /* Check if RWW pending */
@@ -789,6 +796,7 @@ chan_cmd(uint16 dev, uint16 dcmd, uint32 addr)
         return SCPE_BUSY;
 
     /* Ok, try and find the unit */
+    CHAN_WAKE(chan);
     caddr[chan] = addr;
     assembly[chan] = 0;
     op = dcmd >> 8;
@@ -1020,6 +1028,8 @@ chan_write_char(int chan, uint8 * data, int flags)
     int         unit;
     uint16      msk;
 
+    CHAN_WAKE(chan);
+
     /* Based on channel type get next character */
     switch(CHAN_G_TYPE(chan_unit[chan].flags)) {
     case CHAN_754:
@@ -1113,6 +1123,8 @@ chan_read_char(int chan, uint8 * data, int flags)
     int         unit;
     uint16      msk;
 
+    CHAN_WAKE(chan);
+
     /* Check if he write out last data */
     if ((chan_flags[chan] & STA_ACTIVE) == 0)
         return TIME_ERROR;
@@ -1219,6 +1231,7 @@ chan_read_char(int chan, uint8 * data, int flags)
 void
 chan9_set_error(int chan, uint32 mask)
 {
+    CHAN_WAKE(chan);
     if (chan_flags[chan] & mask)
         return;
     chan_flags[chan] |= mask;
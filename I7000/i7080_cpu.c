@@ -298,6 +298,9 @@ MTAB                cpu_mod[] = {
     {EMULATE3, EMULATE3, "EMU7053", "EMU7053", NULL, NULL, NULL},
     {NONSTOP, 0, "PROGRAM", "PROGRAM", NULL, NULL, NULL},
     {NONSTOP, NONSTOP, "NONSTOP", "NONSTOP", NULL, NULL, NULL},
+    {MTAB_XTD|MTAB_VDV|MTAB_VALO|MTAB_NMO, 1, "PROFILE", "PROFILE",
+       &sim_set_profile, &sim_show_profile, NULL, "Enable instruction profile, PROFILE=RESET clears counts"},
+    {MTAB_XTD|MTAB_VDV, 0, NULL, "NOPROFILE", &sim_set_profile, NULL, NULL, "Disable instruction profile"},
     {MTAB_XTD | MTAB_VDV | MTAB_NMO | MTAB_SHP, 0, "HISTORY", "HISTORY",
      &cpu_set_hist, &cpu_show_hist},
     {0}
@@ -420,10 +423,12 @@ sim_instr(void)
         break;
     }
     reason = 0;
+    CHAN_WAKE_ALL();            /* Channel state may have been changed */
 
     while (reason == 0) {       /* loop until halted */
 
-        chan_proc();
+        if (chan_work)
+            chan_proc();
         if (chwait != 0) {
             if (chan_active(chwait - 1)) {
                 sim_interval = 0;
@@ -619,6 +624,7 @@ stop_cpu:
                          break;
                  }
 
+                 sim_profile (opcode, IC - 5);
                  if (hst_lnt) {      /* history enabled? */
                       hst_p = (hst_p + 1);   /* next entry */
                       if (hst_p >= hst_lnt)
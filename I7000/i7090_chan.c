@@ -252,6 +252,7 @@ chan_reset(DEVICE * dptr)
         location[i] = 0;
         counter[i] = 0;
     }
+    CHAN_WAKE_ALL();
     return chan_set_devs(dptr);
 }
 
@@ -275,6 +276,7 @@ chan_boot(int32 unit_num, DEVICE * dptr)
     }
     chan_flags[chan] |= STA_ACTIVE;
     chan_flags[chan] &= ~STA_PEND;
+    CHAN_WAKE(chan);
     return SCPE_OK;
 }
 
@@ -324,6 +326,43 @@ bcd_xlat(int chan, int direction)
     assembly[chan] = na;
 }
 
+/* Check if chan_proc has nothing to do on channel until the CPU or
+   a device changes its state. */
+static int
+chan_idle(int chan)
+{
+    uint32              flags = chan_flags[chan];
+
+    if (chan_unit[chan].flags & UNIT_DIS || flags & DEV_DISCO)
+        return 1;
+    switch (CHAN_G_TYPE(chan_unit[chan].flags)) {
+    case CHAN_PIO:
+        return (flags & (DEV_REOR|DEV_SEL|DEV_FULL)) != (DEV_SEL|DEV_REOR);
+#ifdef I7090
+    case CHAN_7289:
+        if ((chan_info[chan] & (CHAINF_RUN | CHAINF_START)) == CHAINF_START)
+            return 0;
+        /* Fall through */
+    case CHAN_7607:
+        if (flags & (CHS_ATTN|STA_TWAIT))
+            return 0;
+        if (flags & STA_WAIT)
+            return (flags & (DEV_REOR|DEV_FULL)) != DEV_REOR;
+        return (flags & STA_ACTIVE) == 0;
+    case CHAN_7909:
+        if (flags & STA_WAIT)
+            return (flags & DEV_REOR) == 0;
+        if (flags & STA_ACTIVE || chan_irq[chan])
+            return 0;
+        /* Same test as interrupt check in chan_proc */
+        return (flags & (DEV_SEL | CTL_CNTL | CTL_SNS | SNS_IRQ | CTL_INHB
+                        | CTL_READ | CTL_WRITE)) != 0 || cmd[chan] == TWT ||
+               (flags & SNS_IRQS & (((sms[chan] ^ 016) | 061) << 5)) == 0;
+#endif
+    }
+    return 0;
+}
+
 /* Execute the next channel instruction. */
 void
 chan_proc()
@@ -333,13 +372,15 @@ chan_proc()
 
     /* Scan channels looking for work */
     for (chan = 0; chan < NUM_CHAN; chan++) {
-        /* Skip if channel is disabled */
-        if (chan_unit[chan].flags & UNIT_DIS)
+        /* Skip channel if nothing changed since it went idle */
+        if ((chan_work & (1 << chan)) == 0)
             continue;
 
-        /* If channel is disconnecting, do nothing */
-        if (chan_flags[chan] & DEV_DISCO)
+        /* Skip if channel is disabled, disconnecting or has nothing to do */
+        if (chan_idle(chan)) {
+            chan_work &= ~(1 << chan);
             continue;
+        }
 
         cmask = 0x0100 << chan;
         switch (CHAN_G_TYPE(chan_unit[chan].flags)) {
@@ -1236,6 +1277,7 @@ chan_rst(int chan, int type)
     wcount[chan] = 0;
     location[chan] = 0;
     counter[chan] = 0;          /* Channel memory address */
+    CHAN_WAKE(chan);
 }
 
 /* Issue a command to a channel */
@@ -1250,6 +1292,7 @@ chan_cmd(uint16 dev, uint16 dcmd)
 
     /* Find device on given channel and give it the command */
     chan = (dev >> 9) & 017;
+    CHAN_WAKE(chan);
     /* If no channel device, quick exit */
     if (chan_unit[chan].flags & UNIT_DIS)
         return SCPE_IOERR;
@@ -1317,6 +1360,7 @@ chan_cmd(uint16 dev, uint16 dcmd)
 int
 chan_start(int chan, uint16 addr)
 {
+    CHAN_WAKE(chan);
     /* Hold this command until after channel has disconnected */
     if (chan_flags[chan] & DEV_DISCO)
         return SCPE_BUSY;
@@ -1354,6 +1398,7 @@ chan_start(int chan, uint16 addr)
 int
 chan_load(int chan, uint16 addr)
 {
+    CHAN_WAKE(chan);
     if (CHAN_G_TYPE(chan_unit[chan].flags) == CHAN_7909) {
         if (chan_flags[chan] & STA_ACTIVE)
             return SCPE_BUSY;
@@ -1444,6 +1489,7 @@ chan_store_diag(int chan, uint16 loc)
 int
 chan_write(int chan, t_uint64 * data, int flags)
 {
+    CHAN_WAKE(chan);
 
     /* Check if last data still not taken */
     if (chan_flags[chan] & DEV_FULL) {
@@ -1487,6 +1533,7 @@ chan_write(int chan, t_uint64 * data, int flags)
 int
 chan_read(int chan, t_uint64 * data, int flags)
 {
+    CHAN_WAKE(chan);
 
     /* Return END_RECORD if requested */
     if (flags & DEV_WEOR) {
@@ -1536,6 +1583,7 @@ chan_read(int chan, t_uint64 * data, int flags)
 int
 chan_write_char(int chan, uint8 * data, int flags)
 {
+    CHAN_WAKE(chan);
     /* If Writing end of record, abort */
     if (chan_flags[chan] & DEV_WEOR) {
         chan_flags[chan] &= ~(DEV_FULL | DEV_WEOR);
@@ -1598,6 +1646,7 @@ chan_write_char(int chan, uint8 * data, int flags)
 int
 chan_read_char(int chan, uint8 * data, int flags)
 {
+    CHAN_WAKE(chan);
 
     /* Return END_RECORD if requested */
     if (flags & DEV_WEOR) {
@@ -1665,6 +1714,7 @@ chan9_seqcheck(int chan)
 void
 chan9_set_error(int chan, uint32 mask)
 {
+    CHAN_WAKE(chan);
     if (chan_flags[chan] & mask)
         return;
     chan_flags[chan] |= mask;
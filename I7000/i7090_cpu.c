@@ -384,6 +384,9 @@ MTAB                cpu_mod[] = {
     {UNIT_DUALCORE, 0, NULL, "STANDARD", NULL, NULL, NULL},
     {UNIT_DUALCORE, UNIT_DUALCORE, "CTSS", "CTSS", NULL, NULL, NULL, "CTSS support"},
 #endif
+    {MTAB_XTD|MTAB_VDV|MTAB_VALO|MTAB_NMO, 1, "PROFILE", "PROFILE",
+       &sim_set_profile, &sim_show_profile, NULL, "Enable instruction profile, PROFILE=RESET clears counts"},
+    {MTAB_XTD|MTAB_VDV, 0, NULL, "NOPROFILE", &sim_set_profile, NULL, NULL, "Disable instruction profile"},
     {MTAB_XTD | MTAB_VDV | MTAB_NMO | MTAB_SHP, 0, "HISTORY", "HISTORY",
      &cpu_set_hist, &cpu_show_hist},
     {0}
@@ -747,6 +750,7 @@ sim_instr(void)
 
     reason = 0;
     hltinst = 0;
+    CHAN_WAKE_ALL();            /* Channel state may have been changed */
 
     /* Enable timer if option set */
     if (cpu_unit.flags & OPTION_TIMER) {
@@ -1001,6 +1005,7 @@ sim_instr(void)
       next_xec:
         opcode = (uint16)(SR >> 24);
         IR = opcode;
+        sim_profile (opcode, IC);
         if (hst_lnt) {  /* history enabled? */
             hst[hst_p].op = SR;
         }
@@ -4141,7 +4146,8 @@ prottrap:
             break;
         }
 
-        chan_proc();            /* process any pending channel events */
+        if (chan_work)
+            chan_proc();        /* process any pending channel events */
         if (instr_count != 0 && --instr_count == 0)
             return SCPE_STEP;
     }                           /* end while */
@@ -175,8 +175,7 @@ print_line(UNIT * uptr, int chan, int unit)
 
     if (outsel & PRINT_3) {
         if (uptr->flags & UNIT_ATT) {
-            sim_fwrite("\r\n", 1, 2, uptr->fileref);
-            uptr->pos += 2;
+            sim_spool_write(uptr, "\r\n", 2);
         }
         if (uptr->flags & ECHO) {
             sim_putchar('\r');
@@ -188,8 +187,7 @@ print_line(UNIT * uptr, int chan, int unit)
 
     if (outsel & PRINT_4) {
         if (uptr->flags & UNIT_ATT) {
-            sim_fwrite("\r\n\r\n", 1, 4, uptr->fileref);
-            uptr->pos += 4;
+            sim_spool_write(uptr, "\r\n\r\n", 4);
         }
         if (uptr->flags & ECHO) {
             sim_putchar('\r');
@@ -231,16 +229,14 @@ print_line(UNIT * uptr, int chan, int unit)
 
         for (i = j; i < 72; i++) {
             if (uptr->flags & UNIT_ATT) {
-                sim_fwrite(" ", 1, 1, uptr->fileref);
-                uptr->pos += 1;
+                sim_spool_write(uptr, " ", 1);
             }
             if (uptr->flags & ECHO)
                 sim_putchar(' ');
         }
     } else {
         if (uptr->flags & UNIT_ATT) {
-            sim_fwrite("\n\r", 1, 2, uptr->fileref);
-            uptr->pos += 2;
+            sim_spool_write(uptr, "\n\r", 2);
         }
         if (uptr->flags & ECHO) {
             sim_putchar('\n');
@@ -274,8 +270,7 @@ print_line(UNIT * uptr, int chan, int unit)
 
     /* Print out buffer */
     if (uptr->flags & UNIT_ATT) {
-        sim_fwrite(lpr_data[unit].lbuff, 1, j+1, uptr->fileref);
-        uptr->pos += j+1;
+        sim_spool_write(uptr, lpr_data[unit].lbuff, j+1);
     }
     if (uptr->flags & ECHO) {
         for(i = 0; i <= j; i++)
@@ -291,8 +286,7 @@ print_line(UNIT * uptr, int chan, int unit)
     /* Space printer */
     if (outsel & PRINT_2) {
         if (uptr->flags & UNIT_ATT) {
-            sim_fwrite("\r\n", 1, 2, uptr->fileref);
-            uptr->pos += 2;
+            sim_spool_write(uptr, "\r\n", 2);
         }
         if (uptr->flags & ECHO) {
             sim_putchar('\r');
@@ -304,8 +298,7 @@ print_line(UNIT * uptr, int chan, int unit)
     if (outsel & PRINT_1) {
         while (uptr->u4 < (int32)uptr->capac) {
             if (uptr->flags & UNIT_ATT) {
-                sim_fwrite("\r\n", 1, 2, uptr->fileref);
-                uptr->pos += 2;
+                sim_spool_write(uptr, "\r\n", 2);
             }
             if (uptr->flags & ECHO) {
                 sim_putchar('\r');
@@ -664,7 +657,7 @@ lpr_attach(UNIT * uptr, CONST char *file)
     if ((r = attach_unit(uptr, file)) != SCPE_OK)
         return r;
     uptr->u5 = 0;
-    return SCPE_OK;
+    return sim_spool_attach(uptr);
 }
 
 t_stat
@@ -203,25 +203,20 @@ cdp_srv(UNIT *uptr) {
         return SCPE_OK;
     }
 
-    /* Copy next column over */
+    /* Copy rest of card over in one transfer */
     if (uptr->COL < 80) {
-        uint8               ch = 0;
-
-        if (chan_read_byte(addr, &ch)) {
-            uptr->CMD |= CDP_CARD;
-        } else {
-            sim_debug(DEBUG_DATA, &cdp_dev, "%d: Char < %02o\n", u, ch);
-            image[uptr->COL++] = sim_ebcdic_to_hol(ch);
-            if (uptr->COL == 80) {
-                uptr->CMD |= CDP_CARD;
-            }
-        }
-        if (uptr->CMD & CDP_CARD) {
-            uptr->CMD &= ~(CDP_CMDMSK);
-            chan_end(addr, SNS_CHNEND);
-            sim_activate(uptr, 80000);
-        } else
-            sim_activate(uptr, 100);
+        uint8               buf[80];
+        int                 n;
+        int                 i;
+
+        n = chan_read_block(addr, buf, 80 - uptr->COL);
+        sim_debug(DEBUG_DATA, &cdp_dev, "%d: Card < %d chars\n", u, n);
+        for (i = 0; i < n; i++)
+            image[uptr->COL++] = sim_ebcdic_to_hol(buf[i]);
+        uptr->CMD |= CDP_CARD;
+        uptr->CMD &= ~(CDP_CMDMSK);
+        chan_end(addr, SNS_CHNEND);
+        sim_activate(uptr, 80000);
     }
     return SCPE_OK;
 }
@@ -252,32 +252,35 @@ cdr_srv(UNIT *uptr) {
        return SCPE_OK;
     }
 
-    /* Copy next column over */
+    /* Copy rest of card over in one transfer */
     if (((uptr->CMD & CDR_CMDMSK) & ~CDR_MODE) == CDR_RD) {
         int                  u = uptr-cdr_unit;
         uint16               xlat;
-        uint8                ch = 0;
-
-        xlat = sim_hol_to_ebcdic(image[uptr->COL]);
-
-        if (xlat == 0x100) {
-            uptr->SNS |= SNS_DATCHK;
-            ch = 0x00;
-        } else
-            ch = (uint8)(xlat&0xff);
-        if (chan_write_byte(addr, &ch)) {
-           uptr->CMD &= ~(CDR_CMDMSK);
-           chan_end(addr, SNS_CHNEND|SNS_DEVEND|(uptr->SNS ? SNS_UNITCHK:0));
-           return SCPE_OK;
-       } else {
-           uptr->COL++;
-           sim_debug(DEBUG_DATA, &cdr_dev, "%d: Char > %02x\n", u, ch);
+        uint8                buf[80];
+        int                  len = 80 - uptr->COL;
+        int                  bad = len;
+        int                  n;
+        int                  i;
+
+        for (i = 0; i < len; i++) {
+            xlat = sim_hol_to_ebcdic(image[uptr->COL + i]);
+            if (xlat == 0x100) {
+                if (bad == len)
+                    bad = i;
+                buf[i] = 0x00;
+            } else
+                buf[i] = (uint8)(xlat&0xff);
         }
-        if (uptr->COL == 80) {
-            uptr->CMD &= ~(CDR_CMDMSK);
-            chan_end(addr, SNS_CHNEND|SNS_DEVEND|(uptr->SNS ? SNS_UNITCHK:0));
-        }
-        sim_activate(uptr, 100);
+        n = chan_write_block(addr, buf, len);
+        sim_debug(DEBUG_DATA, &cdr_dev, "%d: Card > %d chars\n", u, n);
+        /* Invalid punch in any column up to where the channel stopped */
+        if (bad < len && bad <= n)
+            uptr->SNS |= SNS_DATCHK;
+        uptr->COL += n;
+        uptr->CMD &= ~(CDR_CMDMSK);
+        chan_end(addr, SNS_CHNEND|SNS_DEVEND|(uptr->SNS ? SNS_UNITCHK:0));
+        if (n == len)
+            sim_activate(uptr, 100);
     }
     return SCPE_OK;
 }
@@ -617,6 +617,146 @@ chan_write_byte(uint16 addr, uint8 *data) {
     return 0;
 }
 
+/*
+ * Number of whole words a block transfer can move directly between
+ * memory and the device, without going through the byte buffer.
+ * Only simple transfers qualify: word aligned, no indirect addressing,
+ * no skip, not backward, and no data tracing. The count is never
+ * allowed to reach zero, so end of CCW and chaining are always handled
+ * by the byte routines. Returns 0 if the next byte must go the slow way.
+ */
+static int
+chan_block_words(int chan, int len, int wr) {
+    uint32  addr = ccw_addr[chan];
+    uint32  end;
+    int     k;
+    int     words;
+
+    if (len < 4 || ccw_count[chan] <= 4)
+        return 0;
+    if (chan_status[chan] & 0x7f)
+        return 0;
+    if (ccw_flags[chan] & (FLAG_IDA|FLAG_SKIP))
+        return 0;
+    if ((ccw_cmd[chan] & 0xf) == CMD_RDBWD)
+        return 0;
+    if ((addr & 0x3) != 0 || chan_byte[chan] != BUFF_EMPTY)
+        return 0;
+    if (sim_deb != NULL && (cpu_dev.dctrl & DEBUG_CDATA) != 0)
+        return 0;
+    words = len / 4;
+    if (words > (ccw_count[chan] - 1) / 4)
+        words = (ccw_count[chan] - 1) / 4;
+    /* Stay within one storage key block and within memory */
+    end = (addr | 0x7ff) + 1;
+    if (end > MEMSIZE)
+        end = MEMSIZE;
+    if (addr >= end)
+        return 0;
+    if (words > (int)((end - addr) >> 2))
+        words = (end - addr) >> 2;
+    if (ccw_key[chan] != 0) {
+        if ((cpu_unit[0].flags & FEAT_PROT) == 0)
+            return 0;
+        k = key[addr >> 11];
+        if (wr) {
+            if ((k & 0xf0) != ccw_key[chan])
+                return 0;
+        } else {
+            if ((k & 0x8) != 0 && (k & 0xf0) != ccw_key[chan])
+                return 0;
+        }
+    }
+    return words;
+}
+
+/*
+ * Read a block of bytes from memory for a device.
+ * Returns number of bytes transfered, if less then len the channel
+ * has finished, just as if chan_read_byte had returned 1.
+ */
+int
+chan_read_block(uint16 addr, uint8 *data, int len) {
+    int         chan = find_subchan(addr);
+    int         n = 0;
+    int         words;
+    uint32      word = 0;
+    uint32      *mp;
+
+    if (chan < 0)
+        return 0;
+    while (n < len) {
+        if ((ccw_cmd[chan] & 0x1) != 0 &&
+            (words = chan_block_words(chan, len - n, 0)) != 0) {
+            mp = &M[ccw_addr[chan] >> 2];
+            key[ccw_addr[chan] >> 11] |= 0x4;
+            ccw_addr[chan] += words * 4;
+            ccw_count[chan] -= words * 4;
+            while (words-- > 0) {
+                word = *mp++;
+                data[n++] = (word >> 24) & 0xff;
+                data[n++] = (word >> 16) & 0xff;
+                data[n++] = (word >> 8) & 0xff;
+                data[n++] = word & 0xff;
+            }
+            chan_buf[chan] = word;
+            continue;
+        }
+        if (chan_read_byte(addr, &data[n]))
+            break;
+        n++;
+    }
+    return n;
+}
+
+/*
+ * Write a block of bytes from a device to memory.
+ * Returns number of bytes transfered, if less then len the channel
+ * has finished, just as if chan_write_byte had returned 1.
+ */
+int
+chan_write_block(uint16 addr, uint8 *data, int len) {
+    int         chan = find_subchan(addr);
+    int         n = 0;
+    int         words;
+    uint32      word = 0;
+    uint32      *mp;
+
+    if (chan < 0)
+        return 0;
+    while (n < len) {
+        /* Flush a full buffer left by the byte routine */
+        if (chan_byte[chan] == (BUFF_EMPTY|BUFF_DIRTY) &&
+            (chan_status[chan] & 0x7f) == 0 && (ccw_cmd[chan] & 0x1) == 0 &&
+            ccw_count[chan] != 0 && (ccw_flags[chan] & (FLAG_IDA|FLAG_SKIP)) == 0 &&
+            (ccw_cmd[chan] & 0xf) != CMD_RDBWD) {
+            if (writebuff(chan))
+                break;
+            ccw_addr[chan] += 4 - (ccw_addr[chan] & 0x3);
+            chan_byte[chan] = BUFF_EMPTY;
+        }
+        if ((ccw_cmd[chan] & 0x1) == 0 &&
+            (words = chan_block_words(chan, len - n, 1)) != 0) {
+            mp = &M[ccw_addr[chan] >> 2];
+            key[ccw_addr[chan] >> 11] |= 0x6;
+            ccw_addr[chan] += words * 4;
+            ccw_count[chan] -= words * 4;
+            while (words-- > 0) {
+                word = ((uint32)data[n] << 24) | ((uint32)data[n+1] << 16) |
+                       ((uint32)data[n+2] << 8) | ((uint32)data[n+3]);
+                *mp++ = word;
+                n += 4;
+            }
+            chan_buf[chan] = word;
+            continue;
+        }
+        if (chan_write_byte(addr, &data[n]))
+            break;
+        n++;
+    }
+    return n;
+}
+
 /*
  * A device wishes to inform the CPU it needs some service.
  */
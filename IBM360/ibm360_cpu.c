@@ -107,7 +107,18 @@ uint16       irqaddr;              /* Address of IRQ vector */
 uint16       loading;              /* Doing IPL */
 uint8        interval_irq = 0;     /* Interval timer IRQ */
 uint8        dat_en = 0;           /* Translate addresses */
-uint32       tlb[256];             /* Translation look aside buffer */
+#define TLB_SETS     64                /* Sets in TLB, power of 2 */
+#define TLB_WAYS     4                 /* Entries per set */
+struct tlb_entry {
+    uint32       vpage;            /* Virtual page number */
+    uint32       sto;              /* Segment table it came from */
+    uint32       phys;             /* Physical page and valid flag */
+} tlb[TLB_SETS][TLB_WAYS];        /* Translation look aside buffer */
+struct tlb_entry *tlb_ient;        /* Last instruction fetch entry */
+uint32       tlb_sto;              /* Current segment table tag */
+t_uint64     tlb_hits;             /* TLB statistics */
+t_uint64     tlb_misses;
+t_uint64     tlb_flushes;
 int          page_shift;           /* Amount to shift for page */
 int          page_index;           /* Mask of page index feild */
 int          page_mask;            /* Mask of bits in page address */
@@ -234,7 +245,6 @@ int          timer_tics;           /* Interval Timer is ever 3 tics */
 #define PTE_ADR     0x00fffffe     /* Address of table */
 #define PTE_VALID   0x00000001     /* table valid */
 
-#define TLB_SEG     0x0001f000     /* Segment address */
 #define TLB_VALID   0x80000000     /* Entry valid */
 #define TLB_PHY     0x00000fff     /* Physical page */
 
@@ -266,6 +276,7 @@ t_stat cpu_reset (DEVICE *dptr);
 t_stat cpu_set_size (UNIT *uptr, int32 val, CONST char *cptr, void *desc);
 t_stat cpu_set_hist (UNIT *uptr, int32 val, CONST char *cptr, void *desc);
 t_stat cpu_show_hist (FILE *st, UNIT *uptr, int32 val, CONST void *desc);
+t_stat cpu_show_tlb (FILE *st, UNIT *uptr, int32 val, CONST void *desc);
 t_stat cpu_help (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag,
                      const char *cptr);
 const char          *cpu_description (DEVICE *dptr);
@@ -329,6 +340,11 @@ REG cpu_reg[] = {
 MTAB cpu_mod[] = {
     { MTAB_XTD|MTAB_VDV, 0, "IDLE", "IDLE", &sim_set_idle, &sim_show_idle },
     { MTAB_XTD|MTAB_VDV, 0, NULL, "NOIDLE", &sim_clr_idle, NULL },
+    { MTAB_XTD|MTAB_VDV, 0, "FASTIO", "FASTIO", &sim_set_fastio, &sim_show_fastio },
+    { MTAB_XTD|MTAB_VDV, 0, NULL, "NOFASTIO", &sim_clr_fastio, NULL },
+    { MTAB_XTD|MTAB_VDV|MTAB_VALO|MTAB_NMO, 1, "PROFILE", "PROFILE",
+      &sim_set_profile, &sim_show_profile, NULL, "Enable instruction profile, PROFILE=RESET clears counts" },
+    { MTAB_XTD|MTAB_VDV, 0, NULL, "NOPROFILE", &sim_set_profile, NULL, NULL, "Disable instruction profile" },
     { MTAB_VDV, MEMAMOUNT(1), NULL, "16K", &cpu_set_size },
     { MTAB_VDV, MEMAMOUNT(2), NULL, "32K", &cpu_set_size },
     { MTAB_VDV, MEMAMOUNT(4), NULL, "64K", &cpu_set_size },
@@ -366,6 +382,8 @@ MTAB cpu_mod[] = {
     { EXT_IRQ, EXT_IRQ, "EXT", "EXT", NULL, NULL, NULL, "SET CPU EXT causes external interrupt"},
     { MTAB_XTD|MTAB_VDV|MTAB_NMO|MTAB_SHP, 0, "HISTORY", "HISTORY",
       &cpu_set_hist, &cpu_show_hist },
+    { MTAB_XTD|MTAB_VDV|MTAB_NMO, 0, "TLBSTATS", NULL,
+      NULL, &cpu_show_tlb, NULL, "Show DAT translation buffer statistics" },
     { 0 }
     };
 
@@ -502,14 +520,30 @@ void storepsw(uint32 addr, uint16 ircode) {
  *                 seg_mask = 0xfff
  */
 
+/*
+ * Invalidate all translation look aside buffer entries.
+ */
+void tlb_purge() {
+     memset(tlb, 0, sizeof(tlb));
+     tlb_ient = NULL;
+     tlb_flushes++;
+}
+
 /*
  * Translate an address from virtual to physical.
+ *
+ * The TLB is 4 way set associative, indexed by the low bits of the
+ * page number and tagged with the page and the segment table it was
+ * loaded from. Each set is kept in most recently used order.
  */
 int  TransAddr(uint32 va, uint32 *pa) {
      uint32      seg;
      uint32      page;
      uint32      entry;
      uint32      addr;
+     struct tlb_entry *set;
+     struct tlb_entry hit;
+     int         way;
 
      /* Check address in range */
      va &= AMASK;
@@ -524,19 +558,28 @@ int  TransAddr(uint32 va, uint32 *pa) {
      }
 
      page = (va >> page_shift);
-     seg = (page & 0x1f00) << 4;
+     set = &tlb[page & (TLB_SETS - 1)][0];
      /* Quick check if TLB correct */
-     entry = tlb[page & 0xff];
-     if ((entry & TLB_VALID) != 0 && ((entry ^ seg) & TLB_SEG) == 0) {
-         *pa = (va & page_mask) | ((entry & TLB_PHY) << page_shift);
-         if (*pa >= MEMSIZE) {
-            storepsw(OPPSW, IRC_ADDR);
-            return 1;
+     for (way = 0; way < TLB_WAYS; way++) {
+         if (set[way].vpage == page && set[way].sto == tlb_sto &&
+             (set[way].phys & TLB_VALID) != 0) {
+             tlb_hits++;
+             if (way != 0) {
+                 /* Move to front of set */
+                 hit = set[way];
+                 for (; way > 0; way--)
+                     set[way] = set[way - 1];
+                 set[0] = hit;
+             }
+             *pa = (va & page_mask) | ((set[0].phys & TLB_PHY) << page_shift);
+             if (*pa >= MEMSIZE) {
+                storepsw(OPPSW, IRC_ADDR);
+                return 1;
+             }
+             return 0;
          }
-         return 0;
      }
-     /* Clear whatever was in entry */
-     tlb[page & 0xff] = 0;
+     tlb_misses++;
      /* TLB not correct, try loading correct entry */
      seg = (va >> seg_shift) & seg_mask;   /* Segment number to word address */
      page = (va >> page_shift) & page_index;
@@ -621,9 +664,13 @@ int  TransAddr(uint32 va, uint32 *pa) {
 
      /* Compute correct entry */
      entry >>= pte_shift; /* Move physical to correct spot */
-     page = (va >> page_shift);
-     entry |= ((page & 0x1f00) << 4) | TLB_VALID;
-     tlb[page & 0xff] = entry;
+     entry |= TLB_VALID;
+     /* Replace least recently used entry */
+     for (way = TLB_WAYS - 1; way > 0; way--)
+         set[way] = set[way - 1];
+     set[0].vpage = va >> page_shift;
+     set[0].sto = tlb_sto;
+     set[0].phys = entry;
      *pa = (va & page_mask) | ((entry & TLB_PHY) << page_shift);
      if (*pa >= MEMSIZE) {
         storepsw(OPPSW, IRC_ADDR);
@@ -758,6 +805,66 @@ int ReadHalf(uint32 addr, uint32 *data) {
      return 0;
 }
 
+/*
+ * Fetch a half word of an instruction. Same as ReadHalf, but while
+ * translating reuses the TLB entry of the last fetch, so straight line
+ * code does not search the TLB for every half word.
+ */
+int FetchHalf(uint32 addr, uint32 *data) {
+     uint32     pa;
+     struct tlb_entry *ent = tlb_ient;
+
+     addr &= AMASK;
+     if (addr & 0x1)
+         return ReadHalf(addr, data);
+
+     if (!dat_en) {
+         if (addr >= MEMSIZE) {
+            storepsw(OPPSW, IRC_ADDR);
+            return 1;
+         }
+         pa = addr;
+     } else if (ent != NULL && ent->vpage == (addr >> page_shift) &&
+                ent->sto == tlb_sto && (ent->phys & TLB_VALID) != 0) {
+         tlb_hits++;
+         pa = (addr & page_mask) | ((ent->phys & TLB_PHY) << page_shift);
+         if (pa >= MEMSIZE) {
+            storepsw(OPPSW, IRC_ADDR);
+            return 1;
+         }
+     } else {
+         if (TransAddr(addr, &pa))
+             return 1;
+         /* Translation is now at front of set */
+         tlb_ient = &tlb[(addr >> page_shift) & (TLB_SETS - 1)][0];
+     }
+
+     /* Check storage key */
+     if (st_key != 0) {
+         uint8      k;
+
+         if ((cpu_unit[0].flags & FEAT_PROT) == 0) {
+             storepsw(OPPSW, IRC_PROT);
+             return 1;
+         }
+         k = key[pa >> 11];
+         if ((k & 0x8) != 0 && (k & 0xf0) != st_key) {
+             storepsw(OPPSW, IRC_PROT);
+             return 1;
+         }
+     }
+
+     /* Update access flag */
+     key[pa >> 11] |= 0x4;
+
+     *data = M[pa >> 2];
+     *data >>= (pa & 2) ? 0 : 16;
+     *data &= 0xffff;
+     if (*data & 0x8000)
+         *data |= 0xffff0000;
+     return 0;
+}
+
 /*
  * Update a full word in memory, checking protection
  * and alignment restrictions. Return 1 if failure, 0 if
@@ -1041,6 +1148,223 @@ int WriteHalf(uint32 addr, uint32 data) {
      return 0;
 }
 
+/*
+ * Storage to storage block operations.
+ *
+ * The SS logical instructions work one 2K storage key block at a time.
+ * Translation and protection are checked once for each block, in the same
+ * order the byte at a time loop would check them, so a fault leaves storage,
+ * reference bits and condition code exactly as before. Within a block the
+ * operands are processed a word at a time where the alignment allows it.
+ * PER storage alteration events are tracked per byte, so callers use the
+ * byte loops while they are enabled.
+ */
+
+#define BLK_SIZE    0x800          /* Size of storage key block */
+#define BLK_LEFT(a) (BLK_SIZE - ((a) & (BLK_SIZE - 1)))
+#define MEM_BYTE(pa) ((M[(pa) >> 2] >> (8 * (3 - ((pa) & 0x3)))) & 0xff)
+
+/*
+ * Translate an address and check it may be read (wr == 0) or
+ * updated (wr != 0), setting the reference and change bits.
+ * Return 1 if failure, 0 if success.
+ */
+static int BlockAddr(uint32 va, int wr, uint32 *pa) {
+     if (TransAddr(va, pa))
+         return 1;
+
+     /* Check storage key */
+     if (st_key != 0) {
+         uint8      k;
+
+         if ((cpu_unit[0].flags & FEAT_PROT) == 0) {
+             storepsw(OPPSW, IRC_PROT);
+             return 1;
+         }
+         k = key[*pa >> 11];
+         if ((wr || (k & 0x8) != 0) && (k & 0xf0) != st_key) {
+             storepsw(OPPSW, IRC_PROT);
+             return 1;
+         }
+     }
+     key[*pa >> 11] |= (wr) ? 0x6 : 0x4;
+     return 0;
+}
+
+static void PutMemByte(uint32 pa, uint32 data) {
+     int        offset = 8 * (3 - (pa & 0x3));
+
+     M[pa >> 2] = (M[pa >> 2] & ~(0xffu << offset)) | ((data & 0xff) << offset);
+}
+
+/* Combine source and destination for MVC, MVN, MVZ, NC, OC and XC */
+static uint32 LogicalOp(uint8 op, uint32 dest, uint32 src) {
+     switch(op) {
+     case OP_MVZ: return (dest & 0x0f0f0f0f) | (src & 0xf0f0f0f0);
+     case OP_MVN: return (dest & 0xf0f0f0f0) | (src & 0x0f0f0f0f);
+     case OP_NC:  return dest & src;
+     case OP_OC:  return dest | src;
+     case OP_XC:  return dest ^ src;
+     default:     return src;
+     }
+}
+
+/*
+ * Do a logical operation on len bytes, addr1 is destination and addr2
+ * source. Return 1 if failure, 0 if success.
+ */
+static int LogicalBlock(uint8 op, uint32 addr1, uint32 addr2, uint32 len) {
+     uint32     pa1, pa2;
+     uint32     n, dest;
+     int        setcc = (op == OP_NC || op == OP_OC || op == OP_XC);
+
+     while (len != 0) {
+         addr1 &= AMASK;
+         addr2 &= AMASK;
+         if (BlockAddr(addr2, 0, &pa2))
+             return 1;
+         if (op != OP_MVC && BlockAddr(addr1, 0, &pa1))
+             return 1;
+         /* CC is set from the first byte before the store is checked */
+         if (setcc && LogicalOp(op, MEM_BYTE(pa1), MEM_BYTE(pa2)) != 0)
+             cc = 1;
+         if (BlockAddr(addr1, 1, &pa1))
+             return 1;
+         n = BLK_LEFT(addr1);
+         if (n > BLK_LEFT(addr2))
+             n = BLK_LEFT(addr2);
+         if (n > len)
+             n = len;
+         addr1 += n;
+         addr2 += n;
+         len -= n;
+
+         /* Words can be used if aligned alike and not propagating bytes */
+         if ((pa1 & 0x3) == (pa2 & 0x3) && (pa1 <= pa2 || pa1 >= pa2 + n)) {
+             for (; n != 0 && (pa1 & 0x3) != 0; n--, pa1++, pa2++) {
+                 dest = LogicalOp(op, MEM_BYTE(pa1), MEM_BYTE(pa2));
+                 if (setcc && dest != 0)
+                     cc = 1;
+                 PutMemByte(pa1, dest);
+             }
+             for (; n >= 4; n -= 4, pa1 += 4, pa2 += 4) {
+                 dest = LogicalOp(op, M[pa1 >> 2], M[pa2 >> 2]);
+                 if (setcc && dest != 0)
+                     cc = 1;
+                 M[pa1 >> 2] = dest;
+             }
+         }
+         for (; n != 0; n--, pa1++, pa2++) {
+             dest = LogicalOp(op, MEM_BYTE(pa1), MEM_BYTE(pa2));
+             if (setcc && dest != 0)
+                 cc = 1;
+             PutMemByte(pa1, dest);
+         }
+     }
+     return 0;
+}
+
+/*
+ * Compare len bytes at addr1 with addr2 and set CC.
+ * Return 1 if failure, 0 if success.
+ */
+static int CompareBlock(uint32 addr1, uint32 addr2, uint32 len) {
+     uint32     pa1, pa2;
+     uint32     n, src1, src2;
+
+     cc = 0;
+     while (len != 0) {
+         addr1 &= AMASK;
+         addr2 &= AMASK;
+         if (BlockAddr(addr1, 0, &pa1))
+             return 1;
+         if (BlockAddr(addr2, 0, &pa2))
+             return 1;
+         n = BLK_LEFT(addr1);
+         if (n > BLK_LEFT(addr2))
+             n = BLK_LEFT(addr2);
+         if (n > len)
+             n = len;
+         addr1 += n;
+         addr2 += n;
+         len -= n;
+
+         if ((pa1 & 0x3) == (pa2 & 0x3)) {
+             for (; n != 0 && (pa1 & 0x3) != 0; n--, pa1++, pa2++) {
+                 src1 = MEM_BYTE(pa1);
+                 src2 = MEM_BYTE(pa2);
+                 if (src1 != src2) {
+                     cc = (src1 > src2) ? 2 : 1;
+                     return 0;
+                 }
+             }
+             /* Words hold bytes most significant first */
+             for (; n >= 4; n -= 4, pa1 += 4, pa2 += 4) {
+                 src1 = M[pa1 >> 2];
+                 src2 = M[pa2 >> 2];
+                 if (src1 != src2) {
+                     cc = (src1 > src2) ? 2 : 1;
+                     return 0;
+                 }
+             }
+         }
+         for (; n != 0; n--, pa1++, pa2++) {
+             src1 = MEM_BYTE(pa1);
+             src2 = MEM_BYTE(pa2);
+             if (src1 != src2) {
+                 cc = (src1 > src2) ? 2 : 1;
+                 return 0;
+             }
+         }
+     }
+     return 0;
+}
+
+/*
+ * Translate (TR) or translate and test (TRT) len bytes at addr1 using
+ * the table at addr2. The table must lie within a single storage key
+ * block. Return 1 if failure, 0 if success.
+ */
+static int TranslateBlock(uint8 op, uint32 addr1, uint32 addr2, uint32 len) {
+     uint32     pa1, pat;
+     uint32     n, src1, dest;
+     int        first = 1;
+
+     if (op == OP_TRT)
+         cc = 0;
+     while (len != 0) {
+         addr1 &= AMASK;
+         if (BlockAddr(addr1, 0, &pa1))
+             return 1;
+         if (first) {
+             if (BlockAddr(addr2, 0, &pat))
+                 return 1;
+             first = 0;
+         }
+         if (op == OP_TR && BlockAddr(addr1, 1, &pa1))
+             return 1;
+         n = BLK_LEFT(addr1);
+         if (n > len)
+             n = len;
+         for (; n != 0; n--, pa1++, addr1++, len--) {
+             src1 = MEM_BYTE(pa1);
+             dest = MEM_BYTE(pat + src1);
+             if (op == OP_TR) {
+                 PutMemByte(pa1, dest);
+             } else if (dest != 0) {
+                 regs[1] &= 0xff000000;
+                 regs[1] |= addr1 & AMASK;
+                 regs[2] &= 0xffffff00;
+                 regs[2] |= dest;
+                 per_mod |= 6;
+                 cc = (len == 1) ? 2 : 1;
+                 return 0;
+             }
+         }
+     }
+     return 0;
+}
+
 
 t_stat
 sim_instr(void)
@@ -1084,6 +1408,7 @@ sim_instr(void)
         seg_mask = AMASK >> 20;
         seg_addr = cregs[0] & AMASK;
         seg_len = (((cregs[0] >> 24) & 0xff) + 1) << 4;
+        tlb_sto = cregs[0];
     } else {
         switch((cregs[0] >> 22) & 03) {
         default:   /* Generate translation exception */
@@ -1118,6 +1443,7 @@ sim_instr(void)
         }
         seg_addr = cregs[1] & AMASK;
         seg_len = (((cregs[1] >> 24) & 0xff) + 1) << 4;
+        tlb_sto = cregs[1];
     }
     /* Generate pte index mask */
     page_index = ((~(seg_mask << seg_shift) & ~page_mask) & AMASK) >> page_shift;
@@ -1198,13 +1524,13 @@ wait_loop:
             /* CPU IDLE */
             if (flags & WAIT && irq_en == 0 && ext_en == 0)
                return STOP_HALT;
-            if (sim_idle_enab)
+            if (sim_idle_enab || sim_fastio_enab)
                sim_idle(TMR_RTC, FALSE);
             sim_interval--;
             goto wait_loop;
         }
 
-        if (sim_brk_summ && sim_brk_test(PC, SWMASK('E'))) {
+        if (sim_brk_summ && sim_brk_mapped(PC) && sim_brk_test(PC, SWMASK('E'))) {
            return STOP_IBKPT;
         }
 
@@ -1247,7 +1573,7 @@ wait_loop:
         ilc = 0;
 
         /* Fetch the next instruction */
-        if (ReadHalf(PC, &dest))
+        if (FetchHalf(PC, &dest))
             goto supress;
         if (per_en && (cregs[9] & 0x40000000) != 0) {
             if (cregs[10] <= cregs[11]) {
@@ -1268,10 +1594,11 @@ wait_loop:
         reg = (uint8)(ops[0] & 0xff);
         reg1 = R1(reg);
         op = (uint8)(ops[0] >> 8);
+        sim_profile (op, iPC);
         /* Check if RX, RR, SI, RS, SS opcode */
         if (op & 0xc0) {
             ilc = 2;
-            if (ReadHalf(PC, &dest))
+            if (FetchHalf(PC, &dest))
                 goto supress;
             ops[1] = dest;
             PC += 2;
@@ -1280,7 +1607,7 @@ wait_loop:
             /* Check if SS */
             if ((op & 0xc0) == 0xc0) {
                 ilc = 3;
-                if (ReadHalf(PC, &dest))
+                if (FetchHalf(PC, &dest))
                     goto supress;;
                 ops[2] = dest;
                 PC += 2;
@@ -2279,10 +2606,9 @@ save_dbl:
                                     reg1, addr1, dest, PC, reg);
                         switch (reg1) {
                         case 0x0:     /* Segment table address */
-                                  for (temp = 0;
-                                       temp < sizeof(tlb)/sizeof(uint32);
-                                       temp++)
-                                      tlb[temp] = 0;
+                                  /* Loading CR0 clears associative array */
+                                  tlb_purge();
+                                  tlb_sto = dest;
                                   if ((dest & 0x3f) != 0)
                                      storepsw(OPPSW, IRC_DATA);
                                   seg_addr = dest & AMASK;
@@ -2446,7 +2772,11 @@ save_dbl:
                       goto supress;
                    }
                 }
-                /* Fall through */
+                if (!per_en || (cregs[9] & 0x20000000) == 0) {
+                   if (LogicalBlock(op, addr1, addr2, reg + 1))
+                       goto supress;
+                   break;
+                }
                 do {
                    if (ReadByte(addr2, &src1))
                        goto supress;
@@ -2483,23 +2813,8 @@ save_dbl:
                    if (TransAddr(addr2+reg, &src1))
                       goto supress;
                 }
-                cc = 0;
-                do {
-                    if (ReadByte(addr1, &src1))
-                       goto supress;
-                    if (ReadByte(addr2, &src2))
-                       goto supress;
-                    if (src1 != src2) {
-                       if ((uint32)src1 > (uint32)src2)
-                          cc = 2;
-                       else
-                          cc = 1;
-                       break;
-                    }
-                    addr1++;
-                    addr2++;
-                    reg--;
-                } while(reg != 0xff);
+                if (CompareBlock(addr1, addr2, reg + 1))
+                    goto supress;
                 break;
 
         case OP_TR:
@@ -2514,6 +2829,13 @@ save_dbl:
                    if (TransAddr(addr2+256, &src1))
                       goto supress;
                 }
+                /* Use block path if table in one storage block */
+                if ((addr2 & (BLK_SIZE - 1)) <= (BLK_SIZE - 256) &&
+                    (!per_en || (cregs[9] & 0x20000000) == 0)) {
+                   if (TranslateBlock(op, addr1, addr2, reg + 1))
+                       goto supress;
+                   break;
+                }
                 do {
                    if (ReadByte(addr1, &src1))
                        goto supress;
@@ -2538,6 +2860,11 @@ save_dbl:
                    if (TransAddr(addr2+256, &src1))
                       goto supress;
                 }
+                if ((addr2 & (BLK_SIZE - 1)) <= (BLK_SIZE - 256)) {
+                   if (TranslateBlock(op, addr1, addr2, reg + 1))
+                       goto supress;
+                   break;
+                }
                 cc = 0;
                 do {
                    if (ReadByte(addr1, &src1))
@@ -3118,10 +3445,7 @@ save_dbl:
                                   storepsw(OPPSW, IRC_OPR);
                                   goto supress;
                               }
-                              for (temp = 0;
-                                   temp < sizeof(tlb)/sizeof(uint32);
-                                   temp++)
-                                   tlb[temp] = 0;
+                              tlb_purge();
                               break;
                    case 0x10: /* SPX */
                               storepsw(OPPSW, IRC_OPR);
@@ -3294,6 +3618,7 @@ save_dbl:
                                     b s t xxxxx ps 0 ss xxx iiiiiixxiiixxxxx|
                                     m s d                   mmmmct  iIE     |
                                   */
+                                  temp = (page_shift << 8) | seg_shift;
                                   page_shift = 0;
                                   seg_shift = 0;
                                   switch((dest >> 22) & 03) {
@@ -3330,16 +3655,19 @@ save_dbl:
                                   /* Generate pte index mask */
                                   page_index = ((~(seg_mask << seg_shift) &
                                                   ~page_mask) & AMASK) >> page_shift;
+                                  /* Entries are only good for one format */
+                                  if (temp != ((page_shift << 8) | seg_shift))
+                                      tlb_purge();
                                   intval_en = ((dest & 0x400) != 0);
                                   tod_en = ((dest & 0x800) != 0);
                                   break;
                         case 0x1:     /* Segment table address and length */
                                   seg_addr = dest & AMASK;
                                   seg_len = (((dest >> 24) & 0xff) + 1) << 4;
-                                  for (temp = 0;
-                                       temp < sizeof(tlb)/sizeof(uint32);
-                                       temp++)
-                                       tlb[temp] = 0;
+                                  /* Entries are tagged by segment table,
+                                     so switching spaces does not purge,
+                                     PTLB does */
+                                  tlb_sto = dest;
                                   break;
                         case 0x2:     /* Masks */
                                   if (ec_mode)
@@ -5830,8 +6158,8 @@ t_stat cpu_reset (DEVICE *dptr)
     st_key = cc = pmsk = ec_mode = interval_irq = flags = 0;
     dat_en = irq_en = ext_en = per_en = 0;
     clk_state = CLOCK_UNSET;
-    for (i = 0; i < 256; i++)
-       tlb[i] = 0;
+    tlb_purge();
+    tlb_hits = tlb_misses = tlb_flushes = 0;
     for (i = 0; i < 4096; i++)
        key[i] = 0;
     for (i = 0; i < 16; i++)
@@ -6129,6 +6457,22 @@ cpu_show_hist(FILE * st, UNIT * uptr, int32 val, CONST void *desc)
     return SCPE_OK;
 }
 
+/* Show TLB statistics */
+
+t_stat
+cpu_show_tlb(FILE * st, UNIT * uptr, int32 val, CONST void *desc)
+{
+    t_uint64    total = tlb_hits + tlb_misses;
+
+    fprintf(st, "TLB %d sets x %d ways\n", TLB_SETS, TLB_WAYS);
+    fprintf(st, "Hits:     %" LL_FMT "u\n", tlb_hits);
+    fprintf(st, "Misses:   %" LL_FMT "u\n", tlb_misses);
+    fprintf(st, "Flushes:  %" LL_FMT "u\n", tlb_flushes);
+    if (total != 0)
+        fprintf(st, "Hit rate: %.2f%%\n", (100.0 * tlb_hits) / total);
+    return SCPE_OK;
+}
+
 
 t_stat              cpu_help(FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, const char *cptr)
 {
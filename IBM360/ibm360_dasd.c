@@ -59,8 +59,15 @@
 #include "ibm360_defs.h"
 
 #ifdef NUM_DEVS_DASD
+#if defined (__linux__) || defined (__APPLE__)
+#include <sys/mman.h>
+#define DASD_MMAP
+#endif
+
 #define UNIT_V_TYPE        (UNIT_V_UF + 0)
 #define UNIT_TYPE          (0xf << UNIT_V_TYPE)
+#define UNIT_V_MMAP        (UNIT_V_UF + 4)
+#define UNIT_MMAP          (1 << UNIT_V_MMAP)     /* Map whole image */
 
 #define GET_TYPE(x)        ((UNIT_TYPE & (x)) >> UNIT_V_TYPE)
 #define SET_TYPE(x)         (UNIT_TYPE & ((x) << UNIT_V_TYPE))
@@ -198,8 +205,30 @@ struct dasd_t
      uint8              rec;     /* Current record number */
      uint8              ovfl;    /* Current record overflow record */
      uint16             count;   /* Remaining in current operation */
+#if defined(DASD_MMAP)
+     uint8             *mbase;   /* Mapped image, NULL if not mapped */
+     size_t             msize;   /* Size of mapping */
+#endif
+#if defined(SIM_ASYNCH_IO)
+     uint8             *pbuf;    /* Prefetched cylinder */
+     uint8             *wbuf;    /* Cylinder being written back */
+     int32              pcyl;    /* Cylinder in pbuf, -1 if none */
+     uint32             ppos;    /* File position of pbuf */
+     uint32             wpos;    /* File position of wbuf */
+     int                io_req;  /* Requests for I/O thread */
+     pthread_t          io_thread;
+     pthread_mutex_t    io_lock;
+     pthread_cond_t     io_cond; /* Signaled when io_req changes */
+#endif
 };
 
+#if defined(SIM_ASYNCH_IO)
+/* Requests for the I/O thread, writes are always done before reads */
+#define IO_WRITE           0x1        /* Write wbuf to wpos */
+#define IO_READ            0x2        /* Read ppos into pbuf */
+#define IO_EXIT            0x4        /* Thread should exit */
+#endif
+
 struct disk_t
 {
     const char         *name;         /* Type Name */
@@ -259,6 +288,26 @@ t_stat              dasd_get_type(FILE * st, UNIT * uptr, int32 v,
 t_stat              dasd_help (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag,
                         const char *cptr);
 const char          *dasd_description (DEVICE *dptr);
+#if defined(SIM_ASYNCH_IO)
+void                dasd_prefetch(UNIT *uptr);
+void                dasd_io_start(UNIT *uptr);
+void                dasd_io_stop(UNIT *uptr);
+#else
+#define dasd_prefetch(uptr)
+#define dasd_io_start(uptr)
+#define dasd_io_stop(uptr)
+#endif
+#if defined(DASD_MMAP)
+int                 dasd_map(UNIT *uptr);
+void                dasd_unmap(UNIT *uptr);
+#else
+#define dasd_map(uptr)     0
+#define dasd_unmap(uptr)
+#endif
+t_stat              dasd_set_mmap(UNIT * uptr, int32 val, CONST char *cptr,
+                                 void *desc);
+t_stat              dasd_set_flush(UNIT * uptr, int32 val, CONST char *cptr,
+                                 void *desc);
 
 MTAB                dasd_mod[] = {
     {MTAB_XTD | MTAB_VUN | MTAB_VALR, 0, "TYPE", "TYPE",
@@ -267,6 +316,12 @@ MTAB                dasd_mod[] = {
      &dasd_setd_type, NULL, NULL, "Set all drives to type"},
     {MTAB_XTD | MTAB_VDV | MTAB_VALR, 0, "DEV", "DEV", &set_dev_addr,
         &show_dev_addr, NULL},
+    {UNIT_MMAP, UNIT_MMAP, "MMAP", "MMAP", &dasd_set_mmap, NULL, NULL,
+        "Map whole image into memory at attach"},
+    {UNIT_MMAP, 0, NULL, "NOMMAP", &dasd_set_mmap, NULL, NULL,
+        "Buffer one cylinder at a time"},
+    {MTAB_XTD | MTAB_VUN, 0, NULL, "FLUSH", &dasd_set_flush, NULL, NULL,
+        "Write changed data back to image"},
     {0}
 };
 
@@ -581,6 +636,180 @@ void dasd_adjpos(UNIT * uptr)
      }
 }
 
+#if defined(SIM_ASYNCH_IO)
+/*
+ * Cylinder I/O thread. Writes back the cylinder given up at the last
+ * cylinder change, and reads in the cylinder a seek is moving to, so
+ * the simulator does not wait on either.
+ */
+static void *
+dasd_io_thread(void *arg)
+{
+    UNIT               *uptr = (UNIT *)arg;
+    struct dasd_t      *data = (struct dasd_t *)(uptr->up7);
+    uint32              tsize = data->tsize * disk_type[GET_TYPE(uptr->flags)].heads;
+    int                 req;
+
+    pthread_mutex_lock(&data->io_lock);
+    for (;;) {
+        while (data->io_req == 0)
+            pthread_cond_wait(&data->io_cond, &data->io_lock);
+        req = data->io_req;
+        if (req & IO_EXIT)
+            break;
+        pthread_mutex_unlock(&data->io_lock);
+        if (req & IO_WRITE) {
+            (void)sim_fseek(uptr->fileref, data->wpos, SEEK_SET);
+            (void)sim_fwrite(data->wbuf, 1, tsize, uptr->fileref);
+        }
+        if (req & IO_READ) {
+            (void)sim_fseek(uptr->fileref, data->ppos, SEEK_SET);
+            (void)sim_fread(data->pbuf, 1, tsize, uptr->fileref);
+        }
+        pthread_mutex_lock(&data->io_lock);
+        data->io_req &= ~(IO_WRITE|IO_READ);
+        pthread_cond_broadcast(&data->io_cond);
+    }
+    pthread_mutex_unlock(&data->io_lock);
+    return NULL;
+}
+
+/* Wait for I/O thread to finish all requests */
+static void
+dasd_io_wait(struct dasd_t *data)
+{
+    pthread_mutex_lock(&data->io_lock);
+    while ((data->io_req & (IO_WRITE|IO_READ)) != 0)
+        pthread_cond_wait(&data->io_cond, &data->io_lock);
+    pthread_mutex_unlock(&data->io_lock);
+}
+
+/* Hand requests to the I/O thread, it must be idle */
+static void
+dasd_io_post(struct dasd_t *data, int req)
+{
+    pthread_mutex_lock(&data->io_lock);
+    data->io_req |= req;
+    pthread_cond_broadcast(&data->io_cond);
+    pthread_mutex_unlock(&data->io_lock);
+}
+
+/* Start reading the cylinder a seek is going to */
+void
+dasd_prefetch(UNIT *uptr)
+{
+    struct dasd_t      *data = (struct dasd_t *)(uptr->up7);
+    int                 type = GET_TYPE(uptr->flags);
+    int                 cyl = uptr->CCH >> 8;
+
+    if (data->pbuf != NULL && !sim_asynch_enabled)
+        dasd_io_stop(uptr);
+    if (data->pbuf == NULL || cyl == data->ccyl || cyl == data->pcyl ||
+        cyl >= disk_type[type].cyl)
+        return;
+    dasd_io_wait(data);
+    data->pcyl = cyl;
+    data->ppos = sizeof(struct dasd_header) +
+                 (cyl * data->tsize * disk_type[type].heads);
+    dasd_io_post(data, IO_READ);
+}
+
+/* Set up buffers and I/O thread, without SET ASYNCH or if this
+   fails I/O is done inline */
+void
+dasd_io_start(UNIT *uptr)
+{
+    struct dasd_t      *data = (struct dasd_t *)(uptr->up7);
+    uint32              tsize = data->tsize * disk_type[GET_TYPE(uptr->flags)].heads;
+
+    data->pcyl = -1;
+    data->io_req = 0;
+    data->pbuf = data->wbuf = NULL;
+    if (!sim_asynch_enabled)
+        return;
+    data->pbuf = (uint8 *)calloc(tsize, sizeof(uint8));
+    data->wbuf = (uint8 *)calloc(tsize, sizeof(uint8));
+    if (data->pbuf == NULL || data->wbuf == NULL)
+        goto fail;
+    pthread_mutex_init(&data->io_lock, NULL);
+    pthread_cond_init(&data->io_cond, NULL);
+    if (pthread_create(&data->io_thread, NULL, dasd_io_thread, uptr) == 0)
+        return;
+    pthread_cond_destroy(&data->io_cond);
+    pthread_mutex_destroy(&data->io_lock);
+fail:
+    free(data->pbuf);
+    free(data->wbuf);
+    data->pbuf = data->wbuf = NULL;
+}
+
+/* Finish outstanding I/O and stop thread */
+void
+dasd_io_stop(UNIT *uptr)
+{
+    struct dasd_t      *data = (struct dasd_t *)(uptr->up7);
+
+    if (data->pbuf == NULL)
+        return;
+    dasd_io_wait(data);
+    dasd_io_post(data, IO_EXIT);
+    pthread_join(data->io_thread, NULL);
+    pthread_cond_destroy(&data->io_cond);
+    pthread_mutex_destroy(&data->io_lock);
+    free(data->pbuf);
+    free(data->wbuf);
+    data->pbuf = data->wbuf = NULL;
+}
+#endif
+
+#if defined(DASD_MMAP)
+/*
+ * Map whole image file into memory. The cylinder buffer then just
+ * points into the mapping, so changing cylinder costs nothing and
+ * the host writes changed pages back. Read only images get a private
+ * mapping so that updates never reach the file.
+ */
+int
+dasd_map(UNIT *uptr)
+{
+    struct dasd_t      *data = (struct dasd_t *)(uptr->up7);
+    int                 flags = (uptr->flags & UNIT_RO) ? MAP_PRIVATE : MAP_SHARED;
+    void               *base;
+
+    if ((uptr->flags & UNIT_MMAP) == 0)
+        return 0;
+    fflush(uptr->fileref);
+    data->msize = (size_t)sim_fsize_ex(uptr->fileref);
+    base = mmap(NULL, data->msize, PROT_READ | PROT_WRITE, flags,
+                fileno(uptr->fileref), 0);
+    if (base == MAP_FAILED) {
+        sim_messagef(SCPE_OK, "%s: mmap failed, using cylinder buffer: %s\n",
+                     sim_uname(uptr), strerror(errno));
+        return 0;
+    }
+    data->mbase = (uint8 *)base;
+    free(data->cbuf);
+    data->cbuf = data->mbase + data->cpos;
+    uptr->CMD &= ~DK_CYL_DIRTY;
+    return 1;
+}
+
+/* Write back and release mapping */
+void
+dasd_unmap(UNIT *uptr)
+{
+    struct dasd_t      *data = (struct dasd_t *)(uptr->up7);
+
+    if (data->mbase == NULL)
+        return;
+    msync(data->mbase, data->msize, MS_SYNC);
+    munmap(data->mbase, data->msize);
+    data->mbase = NULL;
+    data->cbuf = NULL;
+    uptr->CMD &= ~DK_CYL_DIRTY;
+}
+#endif
+
 /* Handle processing of disk requests. */
 t_stat dasd_srv(UNIT * uptr)
 {
@@ -603,6 +832,61 @@ t_stat dasd_srv(UNIT * uptr)
     /* Check if read or write command, if so grab correct cylinder */
     if (state != DK_POS_SEEK && rd && data->cyl != data->ccyl) {
         uint32 tsize = data->tsize * disk_type[type].heads;
+#if defined(DASD_MMAP)
+        if (data->mbase != NULL) {
+            data->ccyl = data->cyl;
+            data->cpos = sizeof(struct dasd_header) + (data->ccyl * tsize);
+            data->cbuf = data->mbase + data->cpos;
+            uptr->CMD &= ~DK_CYL_DIRTY;
+            sim_debug(DEBUG_DETAIL, dptr, "Map unit=%d cyl=%d %x\n", unit, data->cyl, data->cpos);
+            state = DK_POS_INDEX;
+            goto ntrack;
+        }
+#endif
+#if defined(SIM_ASYNCH_IO)
+        /* Follow SET ASYNCH and SET NOASYNCH */
+        if (data->pbuf != NULL && !sim_asynch_enabled)
+            dasd_io_stop(uptr);
+        else if (data->pbuf == NULL && sim_asynch_enabled)
+            dasd_io_start(uptr);
+        if (data->pbuf != NULL) {
+            uint8  *buf;
+            int     req = 0;
+
+            dasd_io_wait(data);
+            /* Give current cylinder to thread to write back */
+            if (uptr->CMD & DK_CYL_DIRTY) {
+                sim_debug(DEBUG_DETAIL, dptr, "Save unit=%d cyl=%d %x\n", unit, data->ccyl, data->cpos);
+                buf = data->wbuf;
+                data->wbuf = data->cbuf;
+                data->cbuf = buf;
+                data->wpos = data->cpos;
+                req |= IO_WRITE;
+                uptr->CMD &= ~DK_CYL_DIRTY;
+            }
+            data->ccyl = data->cyl;
+            data->cpos = sizeof(struct dasd_header) + (data->ccyl * tsize);
+            /* If seek did not prefetch it, read it now */
+            if (data->pcyl != data->ccyl) {
+                sim_debug(DEBUG_DETAIL, dptr, "Load unit=%d cyl=%d %x\n", unit, data->cyl, data->cpos);
+                data->pcyl = data->ccyl;
+                data->ppos = data->cpos;
+                req |= IO_READ;
+            } else {
+                sim_debug(DEBUG_DETAIL, dptr, "Prefetched unit=%d cyl=%d %x\n", unit, data->cyl, data->cpos);
+            }
+            if (req != 0)
+                dasd_io_post(data, req);
+            if (req & IO_READ)
+                dasd_io_wait(data);
+            buf = data->pbuf;
+            data->pbuf = data->cbuf;
+            data->cbuf = buf;
+            data->pcyl = -1;
+            state = DK_POS_INDEX;
+            goto ntrack;
+        }
+#endif
         if (uptr->CMD & DK_CYL_DIRTY) {
               sim_debug(DEBUG_DETAIL, dptr, "Save unit=%d cyl=%d %x\n", unit, data->ccyl, data->cpos);
               (void)sim_fseek(uptr->fileref, data->cpos, SEEK_SET);
@@ -987,6 +1271,7 @@ sense_end:
              /* Do seek */
              uptr->CMD |= DK_PARAM;
              data->state = DK_POS_SEEK;
+             dasd_prefetch(uptr);
              sim_debug(DEBUG_DETAIL, dptr, "seek unit=%d doing\n", unit);
              chan_end(addr, SNS_CHNEND);
          } else {
@@ -1026,6 +1311,7 @@ sense_end:
              /* Do seek */
              uptr->CMD |= DK_PARAM;
              data->state = DK_POS_SEEK;
+             dasd_prefetch(uptr);
              chan_end(addr, SNS_CHNEND);
          } else {
              uptr->LCMD = cmd;
@@ -1281,6 +1567,7 @@ sense_end:
              uptr->CCH = 0;
              data->tstart = 0;
              data->state = DK_POS_SEEK;
+             dasd_prefetch(uptr);
              sim_debug(DEBUG_DETAIL, dptr, "RD IPL unit=%d seek\n", unit);
              break;
          }
@@ -1437,6 +1724,28 @@ rd:
                  }
                  break;
              }
+             /* Hand rest of data area to channel in one transfer */
+             if (state == DK_POS_DATA && count < data->dlen) {
+                 int    len = data->dlen - count;
+                 int    n = chan_write_block(addr, da, len);
+
+                 sim_debug(DEBUG_DATA, dptr, "RD Block %d of %d %d\n",
+                        n, len, data->tpos);
+                 /* Advance as if one character per step was sent */
+                 i = (n == len) ? n - 1 : n;
+                 data->tpos += i;
+                 data->count += i;
+                 sim_activate_abs(uptr, i + 1);
+                 if (n == len)
+                     break;
+                 sim_debug(DEBUG_DETAIL, dptr,
+                     "RD next unit=%d %02x %02x %02x %02x %02x %02x %02x %02x\n",
+                     unit, da[0], da[1], da[2], da[3], da[4], da[5], da[6], da[7]);
+                 uptr->CMD &= ~(0xff|DK_PARAM);
+                 data->ovfl = 0;
+                 chan_end(addr, SNS_CHNEND|SNS_DEVEND);
+                 break;
+             }
              ch = *da;
              if (state == DK_POS_CNT && count == 0) /* Mask off overflow bit */
                 ch &= 0x7f;
@@ -1711,6 +2020,26 @@ wrckd:
                            data->ovfl);
                  break;
              }
+             /* Take rest of data area from channel in one transfer */
+             if (state == DK_POS_DATA && count < data->dlen &&
+                 (uptr->CMD & DK_DONE) == 0) {
+                 int    len = data->dlen - count;
+                 int    n = chan_read_block(addr, da, len);
+
+                 sim_debug(DEBUG_DATA, dptr, "WR Block %d of %d %d\n",
+                        n, len, data->tpos);
+                 /* Channel ran short, pad with zeros */
+                 if (n < len) {
+                     memset(&da[n], 0, len - n);
+                     uptr->CMD |= DK_DONE;
+                 }
+                 uptr->CMD |= DK_CYL_DIRTY;
+                 /* Advance as if one character per step was received */
+                 data->tpos += len - 1;
+                 data->count += len - 1;
+                 sim_activate_abs(uptr, len);
+                 break;
+             }
              if (uptr->CMD & DK_DONE || chan_read_byte(addr, &ch)) {
                  ch = 0;
                  uptr->CMD |= DK_DONE;
@@ -1971,6 +2300,8 @@ dasd_attach(UNIT * uptr, CONST char *file)
             detach_unit(uptr);
             return SCPE_FMT;
         }
+        if (!dasd_map(uptr))
+            dasd_io_start(uptr);
         return SCPE_OK;
     }
 
@@ -2013,6 +2344,8 @@ dasd_attach(UNIT * uptr, CONST char *file)
     (void)sim_fread(data->cbuf, 1, tsize, uptr->fileref);
     data->cpos = sizeof(struct dasd_header);
     data->ccyl = 0;
+    if (!dasd_map(uptr))
+        dasd_io_start(uptr);
     set_devattn(addr, SNS_DEVEND);
     sim_activate(uptr, 100);
     return SCPE_OK;
@@ -2026,6 +2359,10 @@ dasd_detach(UNIT * uptr)
     uint16              addr = GET_UADDR(uptr->CMD);
     int                 cmd = uptr->CMD & 0x7f;
 
+    if (data) {
+        dasd_io_stop(uptr);
+        dasd_unmap(uptr);
+    }
     if (uptr->CMD & DK_CYL_DIRTY) {
         (void)sim_fseek(uptr->fileref, data->cpos, SEEK_SET);
         (void)sim_fwrite(data->cbuf, 1,
@@ -2057,6 +2394,50 @@ dasd_boot(int32 unit_num, DEVICE * dptr)
 
 /* Disk option setting commands */
 
+t_stat
+dasd_set_mmap(UNIT * uptr, int32 val, CONST char *cptr, void *desc)
+{
+    if (uptr == NULL)
+        return SCPE_IERR;
+    if (uptr->flags & UNIT_ATT)
+        return SCPE_ALATT;
+#if !defined(DASD_MMAP)
+    if (val)
+        return sim_messagef(SCPE_NOFNC, "MMAP not supported on this host\n");
+#endif
+    return SCPE_OK;
+}
+
+t_stat
+dasd_set_flush(UNIT * uptr, int32 val, CONST char *cptr, void *desc)
+{
+    struct dasd_t      *data;
+
+    if (uptr == NULL)
+        return SCPE_IERR;
+    if ((uptr->flags & UNIT_ATT) == 0)
+        return SCPE_UNATT;
+    data = (struct dasd_t *)(uptr->up7);
+#if defined(DASD_MMAP)
+    if (data->mbase != NULL) {
+        msync(data->mbase, data->msize, MS_SYNC);
+        return SCPE_OK;
+    }
+#endif
+#if defined(SIM_ASYNCH_IO)
+    if (data->pbuf != NULL)
+        dasd_io_wait(data);
+#endif
+    if (uptr->CMD & DK_CYL_DIRTY) {
+        (void)sim_fseek(uptr->fileref, data->cpos, SEEK_SET);
+        (void)sim_fwrite(data->cbuf, 1,
+               data->tsize * disk_type[GET_TYPE(uptr->flags)].heads, uptr->fileref);
+        uptr->CMD &= ~DK_CYL_DIRTY;
+    }
+    fflush(uptr->fileref);
+    return SCPE_OK;
+}
+
 t_stat
 dasd_set_type(UNIT * uptr, int32 val, CONST char *cptr, void *desc)
 {
@@ -2138,6 +2519,9 @@ t_stat dasd_help (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag,
     fprintf (st, "Attach command switches\n");
     fprintf (st, "    -I          Initialize the drive. No prompting.\n");
     fprintf (st, "    -V          Adds in a volume label of 11111\n");
+    fprintf (st, "\nSET %sn MMAP maps the whole image into memory when it is attached,\n", dptr->name);
+    fprintf (st, "rather than reading and writing one cylinder at a time. Changes are\n");
+    fprintf (st, "written back on detach or with SET %sn FLUSH.\n\n", dptr->name);
     fprint_set_help (st, dptr);
     fprint_show_help (st, dptr);
     return SCPE_OK;
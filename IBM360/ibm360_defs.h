@@ -345,6 +345,8 @@ void post_extirq();
 int  find_subchan(uint16 device);
 int  chan_read_byte(uint16 chan, uint8 *data);
 int  chan_write_byte(uint16 chan, uint8 *data);
+int  chan_read_block(uint16 chan, uint8 *data, int len);
+int  chan_write_block(uint16 chan, uint8 *data, int len);
 void set_devattn(uint16 addr, uint8 flags);
 void chan_end(uint16 chan, uint8 flags);
 int  startio(uint16 addr) ;
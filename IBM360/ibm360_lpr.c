@@ -195,16 +195,14 @@ print_line(UNIT * uptr)
         out[++i] = '\0';
 
         /* Print out buffer */
-        sim_fwrite(&out, 1, i, uptr->fileref);
-        uptr->pos += i;
+        sim_spool_write(uptr, &out, i);
         sim_debug(DEBUG_DETAIL, &lpr_dev, "%s\n", out);
     }
 
     if (l < 4) {
         while(l != 0) {
-            sim_fwrite("\r\n", 1, 2, uptr->fileref);
+            sim_spool_write(uptr, "\r\n", 2);
             f = 0;
-            uptr->pos += 2;
             uptr->LINE++;
             if (((uint32)uptr->LINE) > uptr->capac)
                 break;
@@ -212,8 +210,8 @@ print_line(UNIT * uptr)
         }
         if ((t_addr)uptr->LINE > uptr->capac) {
            if (f)
-               sim_fwrite("\r\n", 1, 2, uptr->fileref);
-           sim_fwrite("\f", 1, 1, uptr->fileref);
+               sim_spool_write(uptr, "\r\n", 2);
+           sim_spool_write(uptr, "\f", 1);
            uptr->LINE = 1;
         }
         return;
@@ -230,26 +228,23 @@ print_line(UNIT * uptr)
 
     case 3:     /* Even lines */
         if ((uptr->LINE & 1) == 1) {
-            sim_fwrite("\r\n", 1, 2, uptr->fileref);
+            sim_spool_write(uptr, "\r\n", 2);
             f = 0;
-            uptr->pos += 2;
             uptr->LINE++;
         }
         break;
     case 4:     /* Odd lines */
         if ((uptr->LINE & 1) == 0) {
-            sim_fwrite("\r\n", 1, 2, uptr->fileref);
+            sim_spool_write(uptr, "\r\n", 2);
             f = 0;
-            uptr->pos += 2;
             uptr->LINE++;
         }
         break;
     case 5:     /* Half page */
         while((uptr->LINE != (uptr->capac/2)) ||
               (uptr->LINE != (uptr->capac))) {
-            sim_fwrite("\r\n", 1, 2, uptr->fileref);
+            sim_spool_write(uptr, "\r\n", 2);
             f = 0;
-            uptr->pos += 2;
             uptr->LINE++;
             if (((uint32)uptr->LINE) > uptr->capac)
                 break;
@@ -260,9 +255,8 @@ print_line(UNIT * uptr)
               (uptr->LINE != (uptr->capac/2)) ||
               (uptr->LINE != (uptr->capac/2+uptr->capac/4)) ||
               (uptr->LINE != (uptr->capac))) {
-            sim_fwrite("\r\n", 1, 2, uptr->fileref);
+            sim_spool_write(uptr, "\r\n", 2);
             f = 0;
-            uptr->pos += 2;
             uptr->LINE++;
             if (((uint32)uptr->LINE) > uptr->capac)
                 break;
@@ -273,17 +267,16 @@ print_line(UNIT * uptr)
     case 9:
     case 10:
     case 11:
-        sim_fwrite("\r\n", 1, 2, uptr->fileref);
+        sim_spool_write(uptr, "\r\n", 2);
         f = 0;
-        uptr->pos += 2;
         uptr->LINE++;
         break;
     }
 
     if ((t_addr)uptr->LINE > uptr->capac) {
        if (f)
-           sim_fwrite("\r\n", 1, 2, uptr->fileref);
-       sim_fwrite("\f", 1, 1, uptr->fileref);
+           sim_spool_write(uptr, "\r\n", 2);
+       sim_spool_write(uptr, "\f", 1);
        uptr->LINE = 1;
     }
 
@@ -448,7 +441,7 @@ lpr_attach(UNIT * uptr, CONST char *file)
     uptr->LINE = 0;
     uptr->SNS = 0;
     set_devattn(GET_UADDR(uptr->CMD), SNS_DEVEND);
-    return SCPE_OK;
+    return sim_spool_attach(uptr);
 }
 
 t_stat
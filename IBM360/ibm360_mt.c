@@ -453,6 +453,36 @@ t_stat mt_srv(UNIT * uptr)
              sim_debug(DEBUG_DETAIL, dptr, "Block %d chars\n", reclen);
          }
 
+         /* 9 track tapes hand the rest of the record over in one transfer */
+         if ((uptr->flags & MTUF_9TR) != 0) {
+             int     len = uptr->hwmark - uptr->POS;
+             int     n;
+
+             n = chan_write_block(addr, &mt_buffer[bufnum][uptr->POS], len);
+             uptr->POS += n;
+             sim_debug(DEBUG_DATA, dptr, "Read unit=%d %d chars\n\r", unit, n);
+             if (n == len) {
+                 /* Finish when the last character would have arrived */
+                 uptr->CMD |= MT_READDONE;
+                 sim_activate(uptr, (len > 0) ? (len - 1) * 20 : 0);
+                 break;
+             }
+             sim_debug(DEBUG_DATA, dptr, "Read unit=%d EOR\n\r", unit);
+             ch = mt_buffer[bufnum][uptr->POS++];
+             /* If not read whole record, skip till end */
+             if ((t_addr)uptr->POS < uptr->hwmark) {
+                 /* Send dummy character to force SLI */
+                 chan_write_byte(addr, &ch);
+                 sim_activate(uptr, (uptr->hwmark-uptr->POS+n) * 20);
+                 uptr->CMD |= MT_READDONE;
+                 break;
+             }
+             uptr->CMD &= ~MT_CMDMSK;
+             mt_busy[bufnum] &= ~1;
+             chan_end(addr, SNS_DEVEND);
+             break;
+         }
+
          ch = mt_buffer[bufnum][uptr->POS++];
          /* if we are a 7track tape, handle conversion */
          if ((uptr->flags & MTUF_9TR) == 0) {
@@ -565,6 +595,19 @@ t_stat mt_srv(UNIT * uptr)
              mt_buffer[bufnum][uptr->POS++] = ch;
              sim_debug(DEBUG_DATA, dptr, "Write data unit=%d %d %02o\n\r",
                       unit, uptr->POS, ch);
+             /* 9 track tapes take the rest of the record in one transfer */
+             if ((uptr->flags & MTUF_9TR) != 0) {
+                 int     n;
+
+                 n = chan_read_block(addr, &mt_buffer[bufnum][uptr->POS],
+                                     BUFFSIZE - uptr->POS);
+                 uptr->POS += n;
+                 uptr->hwmark = uptr->POS;
+                 sim_debug(DEBUG_DATA, dptr, "Write data unit=%d %d chars\n\r",
+                          unit, n);
+                 sim_activate(uptr, (n + 1) * 20);
+                 break;
+             }
              uptr->hwmark = uptr->POS;
          }
          sim_activate(uptr, 20);
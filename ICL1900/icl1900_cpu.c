@@ -305,6 +305,11 @@ MTAB                cpu_mod[] = {
     {MTAB_VDV, 0, "MEMORY", NULL, NULL, &cpu_show_size},
     {MTAB_XTD|MTAB_VDV, 0, "IDLE", "IDLE", &sim_set_idle, &sim_show_idle },
     {MTAB_XTD|MTAB_VDV, 0, NULL, "NOIDLE", &sim_clr_idle, NULL },
+    {MTAB_XTD|MTAB_VDV, 0, "FASTIO", "FASTIO", &sim_set_fastio, &sim_show_fastio },
+    {MTAB_XTD|MTAB_VDV, 0, NULL, "NOFASTIO", &sim_clr_fastio, NULL },
+    {MTAB_XTD|MTAB_VDV|MTAB_VALO|MTAB_NMO, 1, "PROFILE", "PROFILE",
+       &sim_set_profile, &sim_show_profile, NULL, "Enable instruction profile, PROFILE=RESET clears counts"},
+    {MTAB_XTD|MTAB_VDV, 0, NULL, "NOPROFILE", &sim_set_profile, NULL, NULL, "Disable instruction profile"},
     {MTAB_XTD | MTAB_VDV | MTAB_NMO | MTAB_SHP, 0, "HISTORY", "HISTORY",
      &cpu_set_hist, &cpu_show_hist},
     {0}
@@ -525,6 +530,7 @@ obey:
        RM = temp & 037777;
        RF = 0177 & (temp >> 14);
        RX = 07 & (temp >> 21);
+       sim_profile (RF, RC - 1);
        /* Check if branch opcode */
        if (RF >= 050 && RF < 0100) {
            RA = XR[RX];
@@ -1238,6 +1244,12 @@ branch:
                     /* If priorit mode -> 164 */
                     switch(RX) {
                     case 0:  /* BRN */
+                          /* Check if possible idle loop, jump to self
+                             waiting for an interrupt */
+                          if ((sim_idle_enab || sim_fastio_enab) &&
+                              !exe_mode && !OPIP &&
+                              RB == ((RC - 1) & ((Mode & (EJM|AM22)) ? M22: M15)))
+                              sim_idle(TMR_RTC, FALSE);
                           goto branch;
 
                     case 1:  /* BVS */
@@ -234,6 +234,44 @@ void eds8_cmd(int dev, uint32 cmd, uint32 *resp) {
     return;
 }
 
+/* Read sector at word address da into eds8_buffer */
+static void eds8_read_sec (UNIT *uptr, int da)
+{
+    uint8       *map = sim_fmap_ptr(uptr, (t_offset)da * sizeof(uint32), sizeof(eds8_buffer));
+    int          wc;
+
+    if (map != NULL) {
+        /* Mapped image, no file I/O */
+        if (sim_end)
+            memcpy(&eds8_buffer[0], map, sizeof(eds8_buffer));
+        else
+            sim_buf_copy_swapped(&eds8_buffer[0], map, sizeof(uint32), WD_SEC);
+        return;
+    }
+    (void)sim_fseek(uptr->fileref, da * sizeof(uint32), SEEK_SET);
+    wc = sim_fread(&eds8_buffer[0], sizeof(uint32), WD_SEC, uptr->fileref);
+    while(wc < WD_SEC)
+       eds8_buffer[wc++] = 0;
+}
+
+/* Write eds8_buffer to sector at word address da */
+static void eds8_write_sec (UNIT *uptr, int da)
+{
+    uint8       *map = sim_fmap_ptr(uptr, (t_offset)da * sizeof(uint32), sizeof(eds8_buffer));
+
+    if (map != NULL) {
+        /* Mapped image, store straight into it */
+        if (sim_end)
+            memcpy(map, &eds8_buffer[0], sizeof(eds8_buffer));
+        else
+            sim_buf_copy_swapped(map, &eds8_buffer[0], sizeof(uint32), WD_SEC);
+        sim_fmap_dirty(uptr);
+        return;
+    }
+    (void)sim_fseek(uptr->fileref, da * sizeof(uint32), SEEK_SET);
+    (void)sim_fwrite(&eds8_buffer[0], sizeof(uint32), WD_SEC, uptr->fileref);
+}
+
 t_stat eds8_svc (UNIT *uptr)
 {
     DEVICE      *dptr = &eds8_dev;
@@ -404,10 +442,7 @@ t_stat eds8_svc (UNIT *uptr)
          }
          da = ((((uptr->CYL * HD_CYL) + ((uptr->HDSEC >> 4) & 017)) * SECT_TRK) +
                 (uptr->HDSEC & 07)) * WD_SEC;
-         (void)sim_fseek(uptr->fileref, da * sizeof(uint32), SEEK_SET);
-         wc = sim_fread(&eds8_buffer[0], sizeof(uint32), WD_SEC, uptr->fileref);
-         while(wc < WD_SEC)
-            eds8_buffer[wc++] = 0;
+         eds8_read_sec(uptr, da);
 
          /* Compute header word */
          if ((uptr->CMD & EDS8_CMD) == EDS8_RD_TRK) {
@@ -505,8 +540,7 @@ t_stat eds8_svc (UNIT *uptr)
 
          da = ((((uptr->CYL * HD_CYL) + ((uptr->HDSEC >> 4) & 017)) * SECT_TRK) +
                 (uptr->HDSEC & 07)) * WD_SEC;
-         (void)sim_fseek(uptr->fileref, da * sizeof(uint32), SEEK_SET);
-         wc = sim_fwrite(&eds8_buffer[0], sizeof(uint32), WD_SEC, uptr->fileref);
+         eds8_write_sec(uptr, da);
     
          uptr->HDSEC += 9;        /* Bump sector number, if more then 8, will bump head */
          /* If empty buffer, fill */
@@ -557,8 +591,7 @@ t_stat eds8_svc (UNIT *uptr)
 
          da = ((((uptr->CYL * HD_CYL) + ((uptr->HDSEC >> 4) & 017)) * SECT_TRK) +
                 (uptr->HDSEC & 07)) * WD_SEC;
-         (void)sim_fseek(uptr->fileref, da * sizeof(uint32), SEEK_SET);
-         wc = sim_fwrite(&eds8_buffer[0], sizeof(uint32), WD_SEC, uptr->fileref);
+         eds8_write_sec(uptr, da);
 
          if (eor) {
              /* Terminate */
@@ -634,7 +667,8 @@ eds8_attach(UNIT * uptr, CONST char *file)
     uptr->CYL = 0;
     uptr->CMD = EDS8_TERM;
     chan_set_done(GET_UADDR(eds8_dev.flags));
-    return SCPE_OK;
+    /* ATTACH -M maps the whole pack */
+    return sim_fmap_attach(uptr, (t_offset)CYLS * HD_CYL * SECT_TRK * WD_SEC * sizeof(uint32));
 }
 
 
@@ -78,6 +78,7 @@ void lpr_nsi_cmd (int dev, uint32 cmd);
 void lpr_nsi_status (int dev, uint32 *resp);
 t_stat lpr_svc (UNIT *uptr);
 t_stat lpr_reset (DEVICE *dptr);
+t_stat lpr_attach (UNIT *uptr, CONST char *cptr);
 t_stat lpr_help (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, const char *cptr);
 CONST char *lpr_description (DEVICE *dptr);
 
@@ -106,7 +107,7 @@ MTAB lpr_mod[] = {
 DEVICE lpr_dev = {
     "LP", lpr_unit, NULL, lpr_mod,
     NUM_DEVS_PTP, 8, 22, 1, 8, 22,
-    NULL, NULL, &lpr_reset, NULL, &attach_unit, &detach_unit,
+    NULL, NULL, &lpr_reset, NULL, &lpr_attach, &detach_unit,
     &lpr_dib, DEV_DISABLE | DEV_DEBUG, 0, dev_debug,
     NULL, NULL, &lpr_help, NULL, NULL, &lpr_description
     };
@@ -315,8 +316,7 @@ t_stat lpr_svc (UNIT *uptr)
     buffer[i++] = '\n';
     buffer[i] = '\0';
 
-    sim_fwrite(&buffer, 1, i, uptr->fileref);
-    uptr->pos += i;
+    sim_spool_write(uptr, &buffer, i);
     /* Check if Done */
     if (eor) {
         uptr->STATUS |= TERMINATE;
@@ -342,6 +342,17 @@ t_stat lpr_reset (DEVICE *dptr)
     return SCPE_OK;
 }
 
+/* Attach */
+
+t_stat lpr_attach (UNIT *uptr, CONST char *cptr)
+{
+    t_stat r;
+
+    if ((r = attach_unit(uptr, cptr)) != SCPE_OK)
+        return r;
+    return sim_spool_attach(uptr);
+}
+
 
 t_stat lpr_help (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, const char *cptr)
 {
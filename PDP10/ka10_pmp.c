@@ -197,6 +197,7 @@
 struct pmp_t
 {
      uint8             *cbuf;    /* Cylinder buffer */
+     uint8             *abuf;    /* Allocated buffer, cbuf unless mapped */
      uint32             cpos;    /* Position of head of cylinder in file */
      uint32             tstart;  /* Location of start of track */
      uint16             ccyl;    /* Current Cylinder number */
@@ -1064,15 +1065,23 @@ t_stat pmp_srv(UNIT * uptr)
     if (rd && data->cyl != data->ccyl) {
         uint32 tsize = data->tsize * disk_type[type].heads;
         if (uptr->CMD & DK_CYL_DIRTY) {
-              (void)sim_fseek(uptr->fileref, data->cpos, SEEK_SET);
-              (void)sim_fwrite(data->cbuf, 1, tsize, uptr->fileref);
+              if (data->cbuf != data->abuf) {
+                  sim_fmap_dirty(uptr);
+              } else {
+                  (void)sim_fseek(uptr->fileref, data->cpos, SEEK_SET);
+                  (void)sim_fwrite(data->cbuf, 1, tsize, uptr->fileref);
+              }
               uptr->CMD &= ~DK_CYL_DIRTY;
         }
         data->ccyl = data->cyl;
         sim_debug(DEBUG_DETAIL, dptr, "Load unit=%d cyl=%d\n", unit, data->cyl);
         data->cpos = sizeof(struct pmp_header) + (data->ccyl * tsize);
-        (void)sim_fseek(uptr->fileref, data->cpos, SEEK_SET);
-        (void)sim_fread(data->cbuf, 1, tsize, uptr->fileref);
+        /* Mapped pack, just point at the cylinder */
+        if ((data->cbuf = sim_fmap_ptr(uptr, data->cpos, tsize)) == NULL) {
+            data->cbuf = data->abuf;
+            (void)sim_fseek(uptr->fileref, data->cpos, SEEK_SET);
+            (void)sim_fread(data->cbuf, 1, tsize, uptr->fileref);
+        }
     }
     sim_debug(DEBUG_EXP, dptr, "state unit=%d %02x %d\n", unit, state, data->tpos);
 
@@ -2163,6 +2172,7 @@ pmp_format(UNIT * uptr, int flag) {
         data->tsize = hdr.tracksize;
         if ((data->cbuf = (uint8 *)calloc(tsize, sizeof(uint8))) == 0)
             return 1;
+        data->abuf = data->cbuf;
         for (cyl = 0; cyl <= disk_type[type].cyl; cyl++) {
             pos = 0;
             for (hd = 0; hd < disk_type[type].heads; hd++) {
@@ -2221,6 +2231,29 @@ pmp_format(UNIT * uptr, int flag) {
         return 1;
 }
 
+/*
+ * Map the pack if attached with -M. The cylinder buffer then points
+ * into the file, so a cylinder change costs no I/O.
+ */
+static t_stat
+pmp_map(UNIT * uptr)
+{
+    struct pmp_t       *data = (struct pmp_t *)uptr->DATAPTR;
+    int                 type = GET_TYPE(uptr->flags);
+    uint32              tsize = data->tsize * disk_type[type].heads;
+    uint8              *map;
+    t_stat              r;
+
+    r = sim_fmap_attach(uptr, sizeof(struct pmp_header) +
+                              (t_offset)tsize * (disk_type[type].cyl + 1));
+    if (data->cpos >= sizeof(struct pmp_header) &&
+        (map = sim_fmap_ptr(uptr, data->cpos, tsize)) != NULL) {
+        data->cbuf = map;
+        uptr->CMD &= ~DK_CYL_DIRTY;
+    }
+    return r;
+}
+
 t_stat
 pmp_attach(UNIT * uptr, CONST char *file)
 {
@@ -2242,7 +2275,7 @@ pmp_attach(UNIT * uptr, CONST char *file)
             detach_unit(uptr);
             return SCPE_FMT;
         }
-        return SCPE_OK;
+        return pmp_map(uptr);
     }
 
     sim_messagef(SCPE_OK, "Drive %03x=%d %d %02x %d\n\r",  addr,
@@ -2278,6 +2311,7 @@ pmp_attach(UNIT * uptr, CONST char *file)
         detach_unit(uptr);
         return SCPE_ARG;
     }
+    data->abuf = data->cbuf;
     if ((sim_switches & SIM_SW_REST) == 0) {
         (void)sim_fseek(uptr->fileref, sizeof(struct pmp_header), SEEK_SET);
         (void)sim_fread(data->cbuf, 1, tsize, uptr->fileref);
@@ -2287,7 +2321,7 @@ pmp_attach(UNIT * uptr, CONST char *file)
         pmp_statusb |= REQ_CH;
     }
     sim_activate(uptr, 100);
-    return SCPE_OK;
+    return pmp_map(uptr);
 }
 
 t_stat
@@ -2298,16 +2332,17 @@ pmp_detach(UNIT * uptr)
     uint16              addr = GET_UADDR(uptr->flags);
     int                 cmd = uptr->CMD & 0x7f;
 
-    if (uptr->CMD & DK_CYL_DIRTY) {
+    /* Mapped cylinder is written back by detach_unit */
+    if ((uptr->CMD & DK_CYL_DIRTY) && data->cbuf == data->abuf) {
         (void)sim_fseek(uptr->fileref, data->cpos, SEEK_SET);
         (void)sim_fwrite(data->cbuf, 1,
                data->tsize * disk_type[type].heads, uptr->fileref);
-        uptr->CMD &= ~DK_CYL_DIRTY;
     }
+    uptr->CMD &= ~DK_CYL_DIRTY;
     if (cmd != 0)
          chan_end(SNS_CHNEND|SNS_DEVEND);
     sim_cancel(uptr);
-    free(data->cbuf);
+    free(data->abuf);
     free(data);
     uptr->DATAPTR = 0;
     uptr->CMD &= ~0xffff;
@@ -2410,6 +2445,9 @@ pmp_help (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag,
     }
     fprintf (st, "Attach command switches\n");
     fprintf (st, "    -I          Initialize the drive. No prompting.\n");
+    fprintf (st, "    -M          Map the pack into memory rather than reading and writing\n");
+    fprintf (st, "                one cylinder at a time. Changes are written back on detach\n");
+    fprintf (st, "                or SAVE.\n");
     fprint_set_help (st, dptr);
     fprint_show_help (st, dptr);
     return SCPE_OK;
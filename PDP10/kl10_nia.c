@@ -24,6 +24,7 @@
 
 
 #include "kx10_defs.h"
+#include "kx10_pack.h"
 #include "sim_ether.h"
 
 #if NUM_DEVS_NIA > 0
@@ -651,33 +652,17 @@ void nia_cpy_mac(uint64 word1, uint64 word2, ETH_MAC *mac)
  */
 uint8 *nia_cpy_to(t_addr addr, uint8 *data, int len)
 {
-    uint64    word;
+    uint8     last[4];
+
     /* Copy full words */
-    while (len > 3) {
-        word = M[addr++];
-        *data++ = (uint8)((word >> 28) & 0xff);
-        *data++ = (uint8)((word >> 20) & 0xff);
-        *data++ = (uint8)((word >> 12) & 0xff);
-        *data++ = (uint8)((word >> 4) & 0xff);
-         len -= 4;
-    }
+    pack_b4(data, &M[addr], len / 4);
+    addr += len / 4;
+    data += len & ~3;
     /* Grab last partial word */
-    if (len) {
-        word = M[addr++];
-        switch (len) {
-        case 3:
-                *data++ = (uint8)((word >> 28) & 0xff);
-                *data++ = (uint8)((word >> 20) & 0xff);
-                *data++ = (uint8)((word >> 12) & 0xff);
-                break;
-        case 2:
-                *data++ = (uint8)((word >> 28) & 0xff);
-                *data++ = (uint8)((word >> 20) & 0xff);
-                break;
-        case 1:
-                *data++ = (uint8)((word >> 28) & 0xff);
-                break;
-        }
+    if (len & 3) {
+        pack_b4(last, &M[addr], 1);
+        memcpy(data, last, len & 3);
+        data += len & 3;
     }
     return data;
 }
@@ -687,35 +672,19 @@ uint8 *nia_cpy_to(t_addr addr, uint8 *data, int len)
  */
 uint8 *nia_cpy_from(t_addr addr, uint8 *data, int len)
 {
-    uint64    word;
+    uint8     last[4];
 
     /* Copy full words */
-    while (len > 3) {
-        word =  (uint64)(*data++) << 28;
-        word |= (uint64)(*data++) << 20;
-        word |= (uint64)(*data++) << 12;
-        word |= (uint64)(*data++) << 4;
-        M[addr++] = word;
-        len -= 4;
-    }
+    unpack_b4(&M[addr], data, len / 4);
+    addr += len / 4;
+    data += len & ~3;
     /* Copy last partial word */
-    if (len) {
-        switch (len) {
-        case 3:
-                word =  (uint64)(*data++) << 28;
-                word |= (uint64)(*data++) << 20;
-                word |= (uint64)(*data++) << 12;
-                break;
-        case 2:
-                word =  (uint64)(*data++) << 28;
-                word |= (uint64)(*data++) << 20;
-                break;
-        case 1:
-                word =  (uint64)(*data++) << 28;
-                break;
-        }
+    if (len & 3) {
+        memset(last, 0, sizeof(last));
+        memcpy(last, data, len & 3);
+        unpack_b4(&M[addr], last, 1);
+        data += len & 3;
     }
-    M[addr++] = word;
     return data;
 }
 
@@ -96,6 +96,9 @@
 
 #include "kx10_defs.h"
 #include "sim_timer.h"
+#if !PDP6
+#include "kx10_pack.h"
+#endif
 #include <time.h>
 
 #define HIST_PC         0x40000000
@@ -506,6 +509,15 @@ REG cpu_reg[] = {
 MTAB cpu_mod[] = {
     { MTAB_XTD|MTAB_VDV, 0, "IDLE", "IDLE", &sim_set_idle, &sim_show_idle },
     { MTAB_XTD|MTAB_VDV, 0, NULL, "NOIDLE", &sim_clr_idle, NULL },
+    { MTAB_XTD|MTAB_VDV, 0, "FASTIO", "FASTIO", &sim_set_fastio, &sim_show_fastio },
+    { MTAB_XTD|MTAB_VDV, 0, NULL, "NOFASTIO", &sim_clr_fastio, NULL },
+    { MTAB_XTD|MTAB_VDV|MTAB_VALO|MTAB_NMO, 1, "PROFILE", "PROFILE",
+      &sim_set_profile, &sim_show_profile, NULL, "Enable instruction profile, PROFILE=RESET clears counts" },
+    { MTAB_XTD|MTAB_VDV, 0, NULL, "NOPROFILE", &sim_set_profile, NULL, NULL, "Disable instruction profile" },
+#if !PDP6
+    { MTAB_XTD|MTAB_VDV|MTAB_NMO, 0, "PACKBENCH", NULL,
+      NULL, &pack_show_bench, NULL, "Time 36 bit word to byte packing" },
+#endif
     { UNIT_MSIZE, 1, "16K", "16K", &cpu_set_size },
     { UNIT_MSIZE, 2, "32K", "32K", &cpu_set_size },
     { UNIT_MSIZE, 3, "48K", "48K", &cpu_set_size },
@@ -2528,7 +2540,7 @@ int Mem_read(int flag, int cur_context, int fetch) {
             irq_flags |= 02000;
             return 1;
         }
-        if (sim_brk_summ && sim_brk_test(AB, SWMASK('R')))
+        if (sim_brk_summ && sim_brk_mapped(AB) && sim_brk_test(AB, SWMASK('R')))
             watch_stop = 1;
         sim_interval--;
         MB = M[addr];
@@ -2566,7 +2578,7 @@ int Mem_write(int flag, int cur_context) {
             irq_flags |= 02000;
             return 1;
         }
-        if (sim_brk_summ && sim_brk_test(AB, SWMASK('W')))
+        if (sim_brk_summ && sim_brk_mapped(AB) && sim_brk_test(AB, SWMASK('W')))
             watch_stop = 1;
         sim_interval--;
         M[addr] = MB;
@@ -2932,7 +2944,7 @@ read:
             nxm_flag = 1;
             return 1;
         }
-        if (sim_brk_summ && sim_brk_test(AB, SWMASK('R')))
+        if (sim_brk_summ && sim_brk_mapped(AB) && sim_brk_test(AB, SWMASK('R')))
             watch_stop = 1;
         sim_interval--;
         MB = M[addr];
@@ -2971,7 +2983,7 @@ write:
             nxm_flag = 1;
             return 1;
         }
-        if (sim_brk_summ && sim_brk_test(AB, SWMASK('W')))
+        if (sim_brk_summ && sim_brk_mapped(AB) && sim_brk_test(AB, SWMASK('W')))
             watch_stop = 1;
          sim_interval--;
         M[addr] = MB;
@@ -3189,7 +3201,7 @@ int Mem_read_its(int flag, int cur_context, int fetch) {
             nxm_flag = 1;
             return 1;
         }
-        if (sim_brk_summ && sim_brk_test(AB, SWMASK('R')))
+        if (sim_brk_summ && sim_brk_mapped(AB) && sim_brk_test(AB, SWMASK('R')))
             watch_stop = 1;
         sim_interval--;
         MB = M[addr];
@@ -3235,7 +3247,7 @@ int Mem_write_its(int flag, int cur_context) {
             nxm_flag = 1;
             return 1;
         }
-        if (sim_brk_summ && sim_brk_test(AB, SWMASK('W')))
+        if (sim_brk_summ && sim_brk_mapped(AB) && sim_brk_test(AB, SWMASK('W')))
             watch_stop = 1;
         sim_interval--;
         M[addr] = MB;
@@ -3524,7 +3536,7 @@ int Mem_read_bbn(int flag, int cur_context, int fetch) {
         nxm_flag = 1;
         return 1;
     }
-    if (sim_brk_summ && sim_brk_test(AB, SWMASK('R')))
+    if (sim_brk_summ && sim_brk_mapped(AB) && sim_brk_test(AB, SWMASK('R')))
         watch_stop = 1;
     sim_interval--;
     MB = M[addr];
@@ -3554,7 +3566,7 @@ int Mem_write_bbn(int flag, int cur_context) {
         nxm_flag = 1;
         return 1;
     }
-    if (sim_brk_summ && sim_brk_test(AB, SWMASK('W')))
+    if (sim_brk_summ && sim_brk_mapped(AB) && sim_brk_test(AB, SWMASK('W')))
         watch_stop = 1;
     sim_interval--;
     M[addr] = MB;
@@ -3613,7 +3625,7 @@ int Mem_read_waits(int flag, int cur_context, int fetch) {
         nxm_flag = 1;
         return 1;
     }
-    if (sim_brk_summ && sim_brk_test(AB, SWMASK('R')))
+    if (sim_brk_summ && sim_brk_mapped(AB) && sim_brk_test(AB, SWMASK('R')))
         watch_stop = 1;
     sim_interval--;
     MB = M[addr];
@@ -3640,7 +3652,7 @@ int Mem_write_waits(int flag, int cur_context) {
         nxm_flag = 1;
         return 1;
     }
-    if (sim_brk_summ && sim_brk_test(AB, SWMASK('W')))
+    if (sim_brk_summ && sim_brk_mapped(AB) && sim_brk_test(AB, SWMASK('W')))
         watch_stop = 1;
     sim_interval--;
     M[addr] = MB;
@@ -3681,7 +3693,7 @@ int Mem_read_ka(int flag, int cur_context, int fetch) {
             nxm_flag = 1;
             return 1;
         }
-        if (sim_brk_summ && sim_brk_test(AB, SWMASK('R')))
+        if (sim_brk_summ && sim_brk_mapped(AB) && sim_brk_test(AB, SWMASK('R')))
             watch_stop = 1;
         sim_interval--;
         MB = M[addr];
@@ -3707,7 +3719,7 @@ int Mem_write_ka(int flag, int cur_context) {
             nxm_flag = 1;
             return 1;
         }
-        if (sim_brk_summ && sim_brk_test(AB, SWMASK('W')))
+        if (sim_brk_summ && sim_brk_mapped(AB) && sim_brk_test(AB, SWMASK('W')))
             watch_stop = 1;
         sim_interval--;
         M[addr] = MB;
@@ -3846,7 +3858,7 @@ int Mem_read(int flag, int cur_context, int fetch) {
             nxm_flag = 1;
             return 1;
         }
-        if (sim_brk_summ && sim_brk_test(AB, SWMASK('R')))
+        if (sim_brk_summ && sim_brk_mapped(AB) && sim_brk_test(AB, SWMASK('R')))
             watch_stop = 1;
         MB = M[addr];
     }
@@ -3872,7 +3884,7 @@ int Mem_write(int flag, int cur_context) {
             nxm_flag = 1;
             return 1;
         }
-        if (sim_brk_summ && sim_brk_test(AB, SWMASK('W')))
+        if (sim_brk_summ && sim_brk_mapped(AB) && sim_brk_test(AB, SWMASK('W')))
             watch_stop = 1;
         M[addr] = MB;
     }
@@ -4042,7 +4054,8 @@ if ((reason = build_dev_tab ()) != SCPE_OK)            /* build, chk dib_tab */
          }
     }
 
-    if (sim_brk_summ && f_load_pc && sim_brk_test(PC, SWMASK('E'))) {
+    if (sim_brk_summ && f_load_pc && sim_brk_mapped(PC) &&
+            sim_brk_test(PC, SWMASK('E'))) {
          reason = STOP_IBKPT;
          break;
     }
@@ -4335,12 +4348,14 @@ st_pi:
 #endif
 
     /* Check if possible idle loop */
-    if (sim_idle_enab &&
+    if ((sim_idle_enab || sim_fastio_enab) &&
           (((FLAGS & USER) != 0 && PC < 020 && AB < 020 && (IR & 0760) == 0340) ||
            (uuo_cycle && (IR & 0740) == 0 && IA == 041))) {
        sim_idle (TMR_RTC, FALSE);
     }
 
+    sim_profile (IR, PC);
+
     /* Update history */
     if (hst_lnt && PC > 017) {
             hst_p = hst_p + 1;
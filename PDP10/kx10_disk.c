@@ -23,6 +23,7 @@
 
 #include "kx10_defs.h"
 #include "kx10_disk.h"
+#include "kx10_pack.h"
 
 /*
  *  SIMH format is number words per sector stored as a 64 bit word.
@@ -66,15 +67,220 @@ static struct disk_formats fmts[] = {
     {0, 0},
 };
 
-t_stat 
+/*
+ *  Optional per unit sector cache. Sectors are held already converted
+ *  to 36 bit words, so hits avoid both the seek/read and the unpacking
+ *  of the DBD9/DLD9 formats. The cache is direct mapped on the sector
+ *  number and write back: dirty sectors go to the container when they
+ *  are displaced, on SET <unit> FLUSH, when the simulator stops, on SAVE
+ *  or on detach. A sector that can't be written stays dirty.
+ */
+
+struct disk_cache {
+    struct disk_cache *next;
+    UNIT        *uptr;
+    int         size;                  /* Number of sectors in cache */
+    int         wps;                   /* Words per sector of data */
+    int32       *sect;                 /* Sector held in each slot, -1 empty */
+    uint8       *dirty;                /* Slot needs writing */
+    uint64      *data;                 /* Cached sector data */
+    t_uint64    hits;
+    t_uint64    misses;
+    t_uint64    wback;
+};
+
+static struct disk_cache *disk_caches = NULL;
+
+#define DEF_CACHE       1024           /* Default sectors per unit */
+#define MAX_CACHE       1048576
+
+static t_stat disk_rd_fmt(UNIT *uptr, uint64 *buffer, int sector, int wps);
+static t_stat disk_wr_fmt(UNIT *uptr, uint64 *buffer, int sector, int wps);
+
+static struct disk_cache *
+disk_find_cache(UNIT *uptr)
+{
+    struct disk_cache *dc;
+
+    for (dc = disk_caches; dc != NULL; dc = dc->next) {
+        if (dc->uptr == uptr)
+            return dc;
+    }
+    return NULL;
+}
+
+/* Write out any dirty sectors */
+static t_stat
+disk_flush_cache(struct disk_cache *dc)
+{
+    t_stat  r = SCPE_OK;
+    int     i;
+
+    if (dc->data == NULL || (dc->uptr->flags & UNIT_ATT) == 0)
+        return SCPE_OK;
+    for (i = 0; i < dc->size; i++) {
+        if (dc->dirty[i]) {
+            if (disk_wr_fmt(dc->uptr, &dc->data[i * dc->wps], dc->sect[i],
+                            dc->wps) != SCPE_OK) {
+                r = SCPE_IOERR;
+                continue;
+            }
+            dc->dirty[i] = 0;
+            dc->wback++;
+        }
+    }
+    if (fflush(dc->uptr->fileref) != 0)
+        r = SCPE_IOERR;
+    return r;
+}
+
+/* Drop all sectors, caller must flush first */
+static void
+disk_clear_cache(struct disk_cache *dc)
+{
+    int     i;
+
+    for (i = 0; i < dc->size; i++) {
+        dc->sect[i] = -1;
+        dc->dirty[i] = 0;
+    }
+}
+
+static void
+disk_free_cache(struct disk_cache *dc)
+{
+    free(dc->sect);
+    free(dc->dirty);
+    free(dc->data);
+    dc->sect = NULL;
+    dc->dirty = NULL;
+    dc->data = NULL;
+    dc->wps = 0;
+}
+
+/* Return slot for sector, allocating data on first use */
+static int
+disk_cache_slot(struct disk_cache *dc, int sector, int wps)
+{
+    if (dc->wps != wps) {
+        if (disk_flush_cache(dc) != SCPE_OK)
+            return -1;
+        free(dc->data);
+        dc->data = (uint64 *)calloc((size_t)dc->size * wps, sizeof(uint64));
+        if (dc->data == NULL) {
+            disk_free_cache(dc);
+            return -1;
+        }
+        if (dc->sect == NULL) {
+            dc->sect = (int32 *)malloc(dc->size * sizeof(int32));
+            dc->dirty = (uint8 *)malloc(dc->size * sizeof(uint8));
+            if (dc->sect == NULL || dc->dirty == NULL) {
+                disk_free_cache(dc);
+                return -1;
+            }
+        }
+        dc->wps = wps;
+        disk_clear_cache(dc);
+    }
+    return sector % dc->size;
+}
+
+t_stat
 disk_read(UNIT *uptr, uint64 *buffer, int sector, int wps)
+{
+    struct disk_cache *dc;
+    uint64  *data;
+    int      slot;
+
+    if (disk_caches == NULL || (dc = disk_find_cache(uptr)) == NULL ||
+        (slot = disk_cache_slot(dc, sector, wps)) < 0)
+        return disk_rd_fmt(uptr, buffer, sector, wps);
+    data = &dc->data[slot * wps];
+    if (dc->sect[slot] == sector) {
+        dc->hits++;
+    } else {
+        dc->misses++;
+        if (dc->dirty[slot]) {
+            if (disk_wr_fmt(uptr, data, dc->sect[slot], wps) != SCPE_OK)
+                return SCPE_IOERR;
+            dc->dirty[slot] = 0;
+            dc->wback++;
+        }
+        if (disk_rd_fmt(uptr, data, sector, wps) != SCPE_OK) {
+            dc->sect[slot] = -1;
+            return SCPE_IOERR;
+        }
+        dc->sect[slot] = sector;
+    }
+    memcpy(buffer, data, wps * sizeof(uint64));
+    return SCPE_OK;
+}
+
+t_stat
+disk_write(UNIT *uptr, uint64 *buffer, int sector, int wps)
+{
+    struct disk_cache *dc;
+    uint64  *data;
+    int      slot;
+
+    if (disk_caches == NULL || (dc = disk_find_cache(uptr)) == NULL ||
+        (slot = disk_cache_slot(dc, sector, wps)) < 0)
+        return disk_wr_fmt(uptr, buffer, sector, wps);
+    data = &dc->data[slot * wps];
+    if (dc->sect[slot] == sector) {
+        dc->hits++;
+    } else {
+        dc->misses++;
+        if (dc->dirty[slot]) {
+            if (disk_wr_fmt(uptr, data, dc->sect[slot], wps) != SCPE_OK)
+                return SCPE_IOERR;
+            dc->wback++;
+        }
+        dc->sect[slot] = sector;
+    }
+    memcpy(data, buffer, wps * sizeof(uint64));
+    dc->dirty[slot] = 1;
+    return SCPE_OK;
+}
+
+/* Bytes in the container for wps words */
+static int
+disk_fmt_bytes(UNIT *uptr, int wps)
+{
+    if (GET_FMT(uptr->flags) == SIMH)
+        return wps * sizeof(uint64);
+    return (wps / 2) * 9;
+}
+
+static t_stat 
+disk_rd_fmt(UNIT *uptr, uint64 *buffer, int sector, int wps)
 {
     int      da;
     int      wc;
     int      bc;
-    int      wp;
-    uint64   temp;
     uint8    conv_buff[2048];
+    uint8    *map;
+
+    /* Mapped container, convert straight from the mapping */
+    bc = disk_fmt_bytes(uptr, wps);
+    if (uptr->fmap != NULL &&
+        (map = sim_fmap_ptr(uptr, (t_offset)sector * bc, bc)) != NULL) {
+        switch(GET_FMT(uptr->flags)) {
+        case SIMH:
+            if (sim_end)
+                memcpy(buffer, map, bc);
+            else
+                sim_buf_copy_swapped(buffer, map, sizeof(uint64), wps);
+            break;
+        case DBD9:
+            unpack_dbd9(buffer, map, wps);
+            break;
+        case DLD9:
+            unpack_dld9(buffer, map, wps);
+            break;
+        }
+        return SCPE_OK;
+    }
     switch(GET_FMT(uptr->flags)) {
     case SIMH:
             da = sector * wps;
@@ -90,20 +296,7 @@ disk_read(UNIT *uptr, uint64 *buffer, int sector, int wps)
             wc = sim_fread (&conv_buff, 1, bc, uptr->fileref);
             while (wc < bc)
                  conv_buff[wc++] = 0;
-            for (wp = wc = 0; wp < wps;) {
-                temp = ((uint64)conv_buff[wc++]) << 28;
-                temp |= ((uint64)conv_buff[wc++]) << 20;
-                temp |= ((uint64)conv_buff[wc++]) << 12;
-                temp |= ((uint64)conv_buff[wc++]) << 4;
-                temp |= ((uint64)conv_buff[wc]) >> 4;
-                buffer[wp++] = temp;
-                temp = ((uint64)conv_buff[wc++] & 0xf) << 32;
-                temp |= ((uint64)conv_buff[wc++]) << 24;
-                temp |= ((uint64)conv_buff[wc++]) << 16;
-                temp |= ((uint64)conv_buff[wc++]) << 8;
-                temp |= ((uint64)conv_buff[wc++]);
-                buffer[wp++] = temp;
-            }
+            unpack_dbd9(buffer, conv_buff, wps);
             break;
 
     case DLD9:
@@ -113,81 +306,75 @@ disk_read(UNIT *uptr, uint64 *buffer, int sector, int wps)
             wc = sim_fread (&conv_buff, 1, bc, uptr->fileref);
             while (wc < bc)
                  conv_buff[wc++] = 0;
-            for (wp = wc = 0; wp < wps;) {
-                temp = ((uint64)conv_buff[wc++]);
-                temp |= ((uint64)conv_buff[wc++]) << 8;
-                temp |= ((uint64)conv_buff[wc++]) << 16;
-                temp |= ((uint64)conv_buff[wc++]) << 24;
-                temp |= ((uint64)conv_buff[wc] & 0xf) << 32;
-                buffer[wp++] = temp;
-                temp = ((uint64)conv_buff[wc++] & 0xf0) >> 4;
-                temp |= ((uint64)conv_buff[wc++]) << 4;
-                temp |= ((uint64)conv_buff[wc++]) << 12;
-                temp |= ((uint64)conv_buff[wc++]) << 20;
-                temp |= ((uint64)conv_buff[wc++]) << 28;
-                buffer[wp++] = temp;
-            }
+            unpack_dld9(buffer, conv_buff, wps);
             break;
      }
+     /* Reading past the end gives zeros, anything else is an error */
+     if (ferror(uptr->fileref)) {
+         clearerr(uptr->fileref);
+         return SCPE_IOERR;
+     }
      return SCPE_OK;
 }
 
-t_stat
-disk_write(UNIT *uptr, uint64 *buffer, int sector, int wps)
+static t_stat
+disk_wr_fmt(UNIT *uptr, uint64 *buffer, int sector, int wps)
 {
     int      da;
     int      wc;
     int      bc;
-    int      wp;
-    uint64   temp;
     uint8    conv_buff[2048];
+    uint8    *map;
+
+    /* Mapped container, convert straight into the mapping */
+    bc = disk_fmt_bytes(uptr, wps);
+    if (uptr->fmap != NULL &&
+        (map = sim_fmap_ptr(uptr, (t_offset)sector * bc, bc)) != NULL) {
+        switch(GET_FMT(uptr->flags)) {
+        case SIMH:
+            if (sim_end)
+                memcpy(map, buffer, bc);
+            else
+                sim_buf_copy_swapped(map, buffer, sizeof(uint64), wps);
+            break;
+        case DBD9:
+            pack_dbd9(map, buffer, wps);
+            break;
+        case DLD9:
+            pack_dld9(map, buffer, wps);
+            break;
+        }
+        sim_fmap_dirty(uptr);
+        return SCPE_OK;
+    }
     switch(GET_FMT(uptr->flags)) {
     case SIMH:
             da = sector * wps;
             (void)sim_fseek(uptr->fileref, da * sizeof(uint64), SEEK_SET);
             wc = sim_fwrite (buffer, sizeof(uint64), wps, uptr->fileref);
+            bc = wps;
             break;
     case DBD9:
             bc = (wps / 2) * 9;
-            for (wp = wc = 0; wp < wps;) {
-                temp = buffer[wp++];
-                conv_buff[wc++] = (uint8)((temp >> 28) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 20) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 12) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 4) & 0xff);
-                conv_buff[wc] = (uint8)((temp & 0xf) << 4);
-                temp = buffer[wp++];
-                conv_buff[wc++] |= (uint8)((temp >> 32) & 0xf);
-                conv_buff[wc++] = (uint8)((temp >> 24) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 16) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 8) & 0xff);
-                conv_buff[wc++] = (uint8)(temp & 0xff);
-            }
+            pack_dbd9(conv_buff, buffer, wps);
             da = sector * bc;
             (void)sim_fseek(uptr->fileref, da, SEEK_SET);
             wc = sim_fwrite (&conv_buff, 1, bc, uptr->fileref);
-            return SCPE_OK;
+            break;
     case DLD9:
             bc = (wps / 2) * 9;
-            for (wp = wc = 0; wp < wps;) {
-                temp = buffer[wp++];
-                conv_buff[wc++] = (uint8)(temp & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 8) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 16) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 24) & 0xff);
-                conv_buff[wc] = (uint8)((temp >> 32)  & 0xf);
-                temp = buffer[wp++];
-                conv_buff[wc++] |= (uint8)((temp << 4) & 0xf0);
-                conv_buff[wc++] = (uint8)((temp >> 4) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 12) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 20) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 28) & 0xff);
-            }
+            pack_dld9(conv_buff, buffer, wps);
             da = sector * bc;
             (void)sim_fseek(uptr->fileref, da, SEEK_SET);
             wc = sim_fwrite (&conv_buff, 1, bc, uptr->fileref);
+            break;
+    default:
             return SCPE_OK;
     }
+    if (wc != bc) {
+        clearerr(uptr->fileref);
+        return SCPE_IOERR;
+    }
     return SCPE_OK;
 }
 
@@ -227,11 +414,94 @@ t_stat disk_show_fmt (FILE *st, UNIT *uptr, int32 val, CONST void *desc)
 }
 
 
+/* Set sector cache size, CACHE{=n} enables, NOCACHE removes */
+t_stat disk_set_cache (UNIT *uptr, int32 val, CONST char *cptr, void *desc)
+{
+    struct disk_cache *dc, **pdc;
+    int32   size = DEF_CACHE;
+    t_stat  r;
+
+    if (uptr == NULL) return SCPE_IERR;
+    if (cptr != NULL && *cptr != 0) {
+        if (val == 0)
+            return SCPE_ARG;
+        size = (int32) get_uint (cptr, 10, MAX_CACHE, &r);
+        if (r != SCPE_OK || size == 0)
+            return SCPE_ARG;
+    }
+    dc = disk_find_cache(uptr);
+    if (dc != NULL) {
+        if ((r = disk_flush_cache(dc)) != SCPE_OK)
+            return r;
+        disk_free_cache(dc);
+        if (val == 0) {
+            for (pdc = &disk_caches; *pdc != dc; pdc = &(*pdc)->next);
+            *pdc = dc->next;
+            free(dc);
+            return SCPE_OK;
+        }
+    } else {
+        if (val == 0)
+            return SCPE_OK;
+        dc = (struct disk_cache *)calloc(1, sizeof(struct disk_cache));
+        if (dc == NULL)
+            return SCPE_MEM;
+        dc->uptr = uptr;
+        dc->next = disk_caches;
+        disk_caches = dc;
+    }
+    dc->size = size;
+    dc->hits = dc->misses = dc->wback = 0;
+    return SCPE_OK;
+}
+
+/* Show sector cache size and counters */
+t_stat disk_show_cache (FILE *st, UNIT *uptr, int32 val, CONST void *desc)
+{
+    struct disk_cache *dc = disk_find_cache(uptr);
+
+    if (dc == NULL) {
+        fprintf (st, "no cache");
+        return SCPE_OK;
+    }
+    fprintf (st, "cache=%d, hits=%" LL_FMT "u, misses=%" LL_FMT "u, writebacks=%"
+             LL_FMT "u", dc->size, dc->hits, dc->misses, dc->wback);
+    return SCPE_OK;
+}
+
+/* Write dirty cached sectors to the container */
+t_stat disk_set_flush (UNIT *uptr, int32 val, CONST char *cptr, void *desc)
+{
+    struct disk_cache *dc;
+    t_stat  r = SCPE_OK;
+
+    if (uptr == NULL) return SCPE_IERR;
+    if (cptr != NULL) return SCPE_ARG;
+    if ((uptr->flags & UNIT_ATT) == 0)
+        return SCPE_UNATT;
+    dc = disk_find_cache(uptr);
+    if (dc != NULL)
+        r = disk_flush_cache(dc);
+    if (r != SCPE_OK)
+        return r;
+    return sim_fmap_sync(uptr);
+}
+
+/* Called by SCP when the simulator stops and on SAVE */
+static void disk_io_flush (UNIT *uptr)
+{
+    struct disk_cache *dc = disk_find_cache(uptr);
+
+    if (dc != NULL && disk_flush_cache(dc) != SCPE_OK)
+        sim_printf ("%s: Error writing cached sectors\n", sim_uname(uptr));
+}
+
 /* Device attach */
 t_stat disk_attach (UNIT *uptr, CONST char *cptr)
 {
     t_stat r;
     char                 gbuf[30];
+    struct disk_cache   *dc;
 
     /* Reset to SIMH format on attach */
     uptr->flags &= ~UNIT_FMT;
@@ -247,13 +517,32 @@ t_stat disk_attach (UNIT *uptr, CONST char *cptr)
     r = attach_unit (uptr, cptr);
     if (r != SCPE_OK)
         return r;
-    return SCPE_OK;
+    if ((dc = disk_find_cache(uptr)) != NULL && dc->sect != NULL)
+        disk_clear_cache(dc);
+    uptr->io_flush = &disk_io_flush;
+    /* Map whole container if asked for, capac is in words */
+    return sim_fmap_attach (uptr, (t_offset)disk_fmt_bytes(uptr, 2) * (uptr->capac / 2));
 }
 
 /* Device detach */
 
 t_stat disk_detach (UNIT *uptr)
 {
+    struct disk_cache *dc = disk_find_cache(uptr);
+    t_stat  r = SCPE_OK;
+
+    if (dc != NULL && dc->sect != NULL) {
+        r = disk_flush_cache(dc);
+        if (r != SCPE_OK)
+            sim_printf ("%s: Error writing cached sectors, changes lost\n",
+                        sim_uname(uptr));
+        disk_clear_cache(dc);
+    }
+    uptr->io_flush = NULL;
+    if (r != SCPE_OK) {
+        (void)detach_unit (uptr);
+        return r;
+    }
     return detach_unit (uptr);
 }
 
@@ -285,5 +574,12 @@ t_stat disk_attach_help(FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, const ch
     fprintf (st, "                is SIMH), other options are DBD9 and DLD9\n");
     fprintf (st, "    -Y          Answer Yes to prompt to overwrite last track (on disk create)\n");
     fprintf (st, "    -N          Answer No to prompt to overwrite last track (on disk create)\n");
+    fprintf (st, "    -M          Map the disk container into memory, sectors are transferred\n");
+    fprintf (st, "                without file I/O. Changes are written back on SET %s FLUSH,\n", dptr->name);
+    fprintf (st, "                detach or SAVE.\n");
+    fprintf (st, "\nSET %s CACHE{=n} keeps up to n (default %d) converted sectors in memory,\n", dptr->name, DEF_CACHE);
+    fprintf (st, "writes are held until the sector is replaced, SET %s FLUSH, the\n", dptr->name);
+    fprintf (st, "simulator stops, SAVE or detach.\n");
+    fprintf (st, "SET %s NOCACHE removes the cache. SHOW %s CACHE displays hit counts.\n", dptr->name, dptr->name);
     return SCPE_OK;
 }
@@ -73,6 +73,12 @@ t_stat disk_write(UNIT *uptr, uint64 *buffer, int sector, int wps);
 t_stat disk_set_fmt (UNIT *uptr, int32 val, CONST char *cptr, void *desc);
 /* Show disk format */
 t_stat disk_show_fmt (FILE *st, UNIT *uptr, int32 val, CONST void *desc);
+/* Set sector cache size */
+t_stat disk_set_cache (UNIT *uptr, int32 val, CONST char *cptr, void *desc);
+/* Show sector cache */
+t_stat disk_show_cache (FILE *st, UNIT *uptr, int32 val, CONST void *desc);
+/* Flush sector cache */
+t_stat disk_set_flush (UNIT *uptr, int32 val, CONST char *cptr, void *desc);
 /* Device attach */
 t_stat disk_attach (UNIT *uptr, CONST char *cptr);
 /* Device detach */
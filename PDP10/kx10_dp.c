@@ -270,6 +270,12 @@ MTAB                dp_mod[] = {
     {UNIT_DTYPE, (RP02_DTYPE << UNIT_V_DTYPE), "RP02", "RP02", &dp_set_type },
     {UNIT_DTYPE, (RP01_DTYPE << UNIT_V_DTYPE), "RP01", "RP01", &dp_set_type },
     {MTAB_XTD|MTAB_VUN, 0, "FORMAT", "FORMAT", NULL, &disk_show_fmt }, 
+    {MTAB_XTD|MTAB_VUN|MTAB_VALO, 1, "CACHE", "CACHE", &disk_set_cache, &disk_show_cache,
+              NULL, "Enable sector cache, CACHE=n sets size" },
+    {MTAB_XTD|MTAB_VUN, 0, NULL, "NOCACHE", &disk_set_cache, NULL,
+              NULL, "Disable sector cache" },
+    {MTAB_XTD|MTAB_VUN, 0, NULL, "FLUSH", &disk_set_flush, NULL,
+              NULL, "Write cached sectors to disk" },
     {0},
 };
 
@@ -647,7 +653,13 @@ t_stat dp_svc (UNIT *uptr)
                     /* Read the block */
                     int da = ((cyl * dp_drv_tab[dtype].surf + surf)
                                    * dp_drv_tab[dtype].sect + sect);
-                    (void)disk_read(uptr, &dp_buf[ctlr][0], da, RP_NUMWD);
+                    if (disk_read(uptr, &dp_buf[ctlr][0], da, RP_NUMWD) != SCPE_OK) {
+                        uptr->STATUS &= ~BUSY;
+                        uptr->STATUS |= PRT_ERR;
+                        uptr->UFLAGS |= DONE;
+                        df10_finish_op(df10, 0);
+                        return SCPE_OK;
+                    }
                     uptr->hwmark = RP_NUMWD;
                     uptr->DATAPTR = 0;
                     sect = sect + 1;
@@ -694,7 +706,14 @@ t_stat dp_svc (UNIT *uptr)
                     /* write block the block */
                     for (; uptr->DATAPTR < RP_NUMWD; uptr->DATAPTR++)
                         dp_buf[ctlr][uptr->DATAPTR] = 0;
-                    (void)disk_write(uptr, &dp_buf[ctlr][0], da, RP_NUMWD);
+                    if (disk_write(uptr, &dp_buf[ctlr][0], da, RP_NUMWD) != SCPE_OK) {
+                        uptr->STATUS &= ~(SRC_DONE|END_CYL|BUSY);
+                        uptr->STATUS |= PRT_ERR;
+                        uptr->UFLAGS |= DONE;
+                        CLR_BUF(uptr);
+                        df10_finish_op(df10, 0);
+                        return SCPE_OK;
+                    }
                     uptr->STATUS |= SRC_DONE;
                     sect = sect + 1;
                     if (sect >= dp_drv_tab[dtype].sect) {
@@ -777,7 +796,14 @@ t_stat dp_svc (UNIT *uptr)
                      /* write block the block */
                      for (; uptr->DATAPTR < RP_NUMWD; uptr->DATAPTR++)
                          dp_buf[ctlr][uptr->DATAPTR] = 0;
-                     (void)disk_write(uptr, &dp_buf[ctlr][0], da, RP_NUMWD);
+                     if (disk_write(uptr, &dp_buf[ctlr][0], da, RP_NUMWD) != SCPE_OK) {
+                         uptr->STATUS &= ~(SRC_DONE|END_CYL|BUSY);
+                         uptr->STATUS |= PRT_ERR;
+                         uptr->UFLAGS |= DONE;
+                         CLR_BUF(uptr);
+                         df10_finish_op(df10, 0);
+                         return SCPE_OK;
+                     }
                      uptr->STATUS |= SRC_DONE;
                      sect = sect + 1;
                      if (sect >= dp_drv_tab[dtype].sect) {
@@ -922,7 +948,8 @@ dp_boot(int32 unit_num, DEVICE * dptr)
 
     addr = (MEMSIZE - 512) & RMASK;
     for (sect = 4; sect <= 7; sect++) {
-        (void)disk_read(uptr, &dp_buf[0][0], sect, RP_NUMWD);
+        if (disk_read(uptr, &dp_buf[0][0], sect, RP_NUMWD) != SCPE_OK)
+            return SCPE_IOERR;
         ptr = 0;
         for(wc = RP_NUMWD; wc > 0; wc--)
             M[addr++] = dp_buf[0][ptr++];
@@ -940,10 +967,10 @@ t_stat dp_attach (UNIT *uptr, CONST char *cptr)
     DIB *dib;
     int ctlr;
 
+    uptr->capac = dp_drv_tab[GET_DTYPE (uptr->flags)].size;
     r = disk_attach (uptr, cptr);
     if (r != SCPE_OK || (sim_switches & SIM_SW_REST) != 0)
         return r;
-    uptr->capac = dp_drv_tab[GET_DTYPE (uptr->flags)].size;
     dptr = find_dev_from_unit(uptr);
     if (dptr == 0)
         return SCPE_OK;
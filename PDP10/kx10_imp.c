@@ -25,6 +25,7 @@
 
 
 #include "kx10_defs.h"
+#include "kx10_pack.h"
 #include "sim_ether.h"
 
 #if NUM_DEVS_IMP > 0
@@ -744,17 +745,13 @@ imp_devirq(uint32 dev, t_addr addr) {
 t_stat imp_srv(UNIT * uptr)
 {
     DEVICE *dptr = find_dev_from_unit(uptr);
-    int     i;
-    int     l;
+    int     n;
 
     if (uptr->STATUS & IMPOB && imp_data.sendq == NULL) {
         if (imp_data.obits == 32)
            imp_data.obuf >>= 4;
-        for (i = imp_data.obits - 1; i >= 0; i--) {
-            imp_data.sbuffer[uptr->OPOS>>3] |=
-                  ((imp_data.obuf >> i) & 1) << (7-(uptr->OPOS & 7));
-            uptr->OPOS++;
-        }
+        pack_bits(imp_data.sbuffer, uptr->OPOS, imp_data.obuf, imp_data.obits);
+        uptr->OPOS += imp_data.obits;
         if (uptr->STATUS & IMPLHW) {
             imp_send_packet (&imp_data, uptr->OPOS >> 3);
             /* Allow room for ethernet header for later */
@@ -768,18 +765,18 @@ t_stat imp_srv(UNIT * uptr)
     }
     if (uptr->STATUS & IMPIB) {
         uptr->STATUS &= ~(IMPIB|IMPLW);
-        imp_data.ibuf = 0;
-        l = (uptr->STATUS & IMPI32) ? 4 : 0;
-        for (i = 35; i >= l; i--) {
-             if ((imp_data.rbuffer[uptr->IPOS>>3] >> (7-(uptr->IPOS & 7))) & 1)
-                 imp_data.ibuf |= ((uint64)1) << i;
-             uptr->IPOS++;
-             if (uptr->IPOS > uptr->ILEN) {
-                uptr->STATUS |= IMPLW;
-                uptr->ILEN = 0;
-                break;
-             }
+        n = (uptr->STATUS & IMPI32) ? 32 : 36;
+        if (uptr->IPOS + n > uptr->ILEN) {
+            /* Last word, take what is left */
+            uptr->STATUS |= IMPLW;
+            n = uptr->ILEN - uptr->IPOS + 1;
+            if (n < 1)
+                n = 1;
         }
+        imp_data.ibuf = unpack_bits(imp_data.rbuffer, uptr->IPOS, n) << (36 - n);
+        uptr->IPOS += n;
+        if (uptr->STATUS & IMPLW)
+            uptr->ILEN = 0;
         uptr->STATUS |= IMPID;
         check_interrupts (uptr);
     }
@@ -197,8 +197,7 @@ lpt_printline(UNIT *uptr, int nl) {
         uptr->LINE = 0;
     }
        
-    sim_fwrite(&lpt_buffer, 1, uptr->POS, uptr->fileref);
-    uptr->pos += uptr->POS;
+    sim_spool_write(uptr, &lpt_buffer, uptr->POS);
     uptr->COL = 0;
     uptr->POS = 0;
     if (ferror (uptr->fileref)) {                           /* error? */
@@ -376,39 +375,34 @@ t_stat lpt_svc (UNIT *uptr)
                       break;
             case 014:     /* Form feed, skip to top of page */
                       lpt_printline(uptr, 0);
-                      sim_fwrite("\014", 1, 1, uptr->fileref);
-                      uptr->pos++;
+                      sim_spool_write(uptr, "\014", 1);
                       uptr->LINE = 0;
                       break;
             case 013:     /* Vertical tab, Skip mod 20 */
                       lpt_printline(uptr, 1);
                       while((uptr->LINE % 20) != 0) {
-                          sim_fwrite("\r\n", 1, 2, uptr->fileref);
-                          uptr->pos+=2;
+                          sim_spool_write(uptr, "\r\n", 2);
                           uptr->LINE++;
                       }
                       break;
             case 020:     /* Skip half page */
                       lpt_printline(uptr, 1);
                       while((uptr->LINE % 30) != 0) {
-                          sim_fwrite("\r\n", 1, 2, uptr->fileref);
-                          uptr->pos+=2;
+                          sim_spool_write(uptr, "\r\n", 2);
                           uptr->LINE++;
                       }
                       break;
             case 021:     /* Skip even lines */
                       lpt_printline(uptr, 1);
                       while((uptr->LINE % 2) != 0) {
-                          sim_fwrite("\r\n", 1, 2, uptr->fileref);
-                          uptr->pos+=2;
+                          sim_spool_write(uptr, "\r\n", 2);
                           uptr->LINE++;
                       }
                       break;
             case 022:     /* Skip triple lines */
                       lpt_printline(uptr, 1);
                       while((uptr->LINE % 3) != 0) {
-                          sim_fwrite("\r\n", 1, 2, uptr->fileref);
-                          uptr->pos+=2;
+                          sim_spool_write(uptr, "\r\n", 2);
                           uptr->LINE++;
                       }
                       break;
@@ -450,6 +444,8 @@ t_stat lpt_attach (UNIT *uptr, CONST char *cptr)
 
     sim_switches |= SWMASK ('A');   /* Position to EOF */
     reason = attach_unit (uptr, cptr);
+    if (reason == SCPE_OK)
+        reason = sim_spool_attach (uptr);
     if (sim_switches & SIM_SW_REST)
         return reason;
     uptr->STATUS &= ~ERR_FLG;
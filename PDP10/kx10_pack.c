@@ -0,0 +1,400 @@
+/* kx10_pack.c: 36 bit word to byte packing.
+
+   Copyright (c) 2026, the authors
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+   THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+   IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+   CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+   These are the conversions between 36 bit words and 8 bit bytes used by
+   the network interfaces and the disk format translator.  The B4 layout
+   has an AVX2 version on x86 hosts, picked at run time.  A hand written
+   SSE2 version was no faster than the plain loop, which compilers already
+   vectorize with SSE2.  The 9 byte layouts move a pair of words as one 64
+   bit value and a byte.
+*/
+
+#include "kx10_defs.h"
+#include "kx10_pack.h"
+
+#if defined(__GNUC__) && ((__GNUC__ >= 5) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define PACK_AVX2 1
+#include <immintrin.h>
+#endif
+
+#define PACK_SCALAR     0
+#define PACK_LAVX2      1
+
+static const char *pack_level_name[] = { "scalar", "AVX2" };
+static int pack_level = -1;            /* Best level host supports */
+static int pack_use = -1;              /* Level in use */
+
+static void
+pack_init(void)
+{
+    pack_level = PACK_SCALAR;
+#if defined(PACK_AVX2)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        pack_level = PACK_LAVX2;
+#endif
+    pack_use = pack_level;
+}
+
+#define PACK_LEVEL()  ((pack_use < 0) ? (pack_init(), pack_use) : pack_use)
+
+#if defined(PACK_AVX2)
+__attribute__((target("avx2"))) static int
+pack_b4_avx2(uint8 *data, const uint64 *words, int nwords)
+{
+    const __m256i shuf = _mm256_setr_epi8(3, 2, 1, 0, 11, 10, 9, 8,
+                                          -1, -1, -1, -1, -1, -1, -1, -1,
+                                          3, 2, 1, 0, 11, 10, 9, 8,
+                                          -1, -1, -1, -1, -1, -1, -1, -1);
+    __m256i w;
+    int     i;
+
+    for (i = 0; i + 4 <= nwords; i += 4) {
+        w = _mm256_srli_epi64(_mm256_loadu_si256((const __m256i *)&words[i]), 4);
+        w = _mm256_shuffle_epi8(w, shuf);
+        w = _mm256_permute4x64_epi64(w, 0x08);
+        _mm_storeu_si128((__m128i *)&data[i * 4], _mm256_castsi256_si128(w));
+    }
+    return i;
+}
+
+__attribute__((target("avx2"))) static int
+unpack_b4_avx2(uint64 *words, const uint8 *data, int nwords)
+{
+    const __m128i bswap = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4,
+                                        11, 10, 9, 8, 15, 14, 13, 12);
+    __m128i b;
+    int     i;
+
+    for (i = 0; i + 4 <= nwords; i += 4) {
+        b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)&data[i * 4]), bswap);
+        _mm256_storeu_si256((__m256i *)&words[i],
+                            _mm256_slli_epi64(_mm256_cvtepu32_epi64(b), 4));
+    }
+    return i;
+}
+#endif
+
+void
+pack_b4(uint8 *data, const uint64 *words, int nwords)
+{
+    uint32  v;
+    int     i = 0;
+
+    switch (PACK_LEVEL()) {
+#if defined(PACK_AVX2)
+    case PACK_LAVX2:
+         i = pack_b4_avx2(data, words, nwords);
+         break;
+#endif
+    }
+    for (data += i * 4; i < nwords; i++) {
+        v = (uint32)(words[i] >> 4);
+        *data++ = (uint8)(v >> 24);
+        *data++ = (uint8)(v >> 16);
+        *data++ = (uint8)(v >> 8);
+        *data++ = (uint8)v;
+    }
+}
+
+void
+unpack_b4(uint64 *words, const uint8 *data, int nwords)
+{
+    uint32  v;
+    int     i = 0;
+
+    switch (PACK_LEVEL()) {
+#if defined(PACK_AVX2)
+    case PACK_LAVX2:
+         i = unpack_b4_avx2(words, data, nwords);
+         break;
+#endif
+    }
+    for (data += i * 4; i < nwords; i++, data += 4) {
+        v = ((uint32)data[0] << 24) | ((uint32)data[1] << 16) |
+            ((uint32)data[2] << 8) | (uint32)data[3];
+        words[i] = ((uint64)v) << 4;
+    }
+}
+
+/*
+ * The 9 byte layouts hold a pair of words as one 72 bit value, which is
+ * moved as 64 bits and a byte.  Compilers turn the byte shifts into a
+ * single byte swapped load or store.
+ */
+void
+pack_dbd9(uint8 *data, const uint64 *words, int nwords)
+{
+    uint64  w0, w1, v;
+    int     i;
+
+    for (i = 0; i + 1 < nwords; i += 2, data += 9) {
+        w0 = words[i] & FMASK;
+        w1 = words[i + 1] & FMASK;
+        v = (w0 << 28) | (w1 >> 8);
+        data[0] = (uint8)(v >> 56);
+        data[1] = (uint8)(v >> 48);
+        data[2] = (uint8)(v >> 40);
+        data[3] = (uint8)(v >> 32);
+        data[4] = (uint8)(v >> 24);
+        data[5] = (uint8)(v >> 16);
+        data[6] = (uint8)(v >> 8);
+        data[7] = (uint8)v;
+        data[8] = (uint8)w1;
+    }
+}
+
+void
+unpack_dbd9(uint64 *words, const uint8 *data, int nwords)
+{
+    uint64  v;
+    int     i;
+
+    for (i = 0; i + 1 < nwords; i += 2, data += 9) {
+        v = ((uint64)data[0] << 56) | ((uint64)data[1] << 48) |
+            ((uint64)data[2] << 40) | ((uint64)data[3] << 32) |
+            ((uint64)data[4] << 24) | ((uint64)data[5] << 16) |
+            ((uint64)data[6] << 8) | (uint64)data[7];
+        words[i] = v >> 28;
+        words[i + 1] = ((v & 01777777777) << 8) | data[8];
+    }
+}
+
+void
+pack_dld9(uint8 *data, const uint64 *words, int nwords)
+{
+    uint64  w0, w1, v;
+    int     i;
+
+    for (i = 0; i + 1 < nwords; i += 2, data += 9) {
+        w0 = words[i] & FMASK;
+        w1 = words[i + 1] & FMASK;
+        v = w0 | (w1 << 36);
+        data[0] = (uint8)v;
+        data[1] = (uint8)(v >> 8);
+        data[2] = (uint8)(v >> 16);
+        data[3] = (uint8)(v >> 24);
+        data[4] = (uint8)(v >> 32);
+        data[5] = (uint8)(v >> 40);
+        data[6] = (uint8)(v >> 48);
+        data[7] = (uint8)(v >> 56);
+        data[8] = (uint8)(w1 >> 28);
+    }
+}
+
+void
+unpack_dld9(uint64 *words, const uint8 *data, int nwords)
+{
+    uint64  v;
+    int     i;
+
+    for (i = 0; i + 1 < nwords; i += 2, data += 9) {
+        v = (uint64)data[0] | ((uint64)data[1] << 8) |
+            ((uint64)data[2] << 16) | ((uint64)data[3] << 24) |
+            ((uint64)data[4] << 32) | ((uint64)data[5] << 40) |
+            ((uint64)data[6] << 48) | ((uint64)data[7] << 56);
+        words[i] = v & FMASK;
+        words[i + 1] = (v >> 36) | ((uint64)data[8] << 28);
+    }
+}
+
+void
+pack_bits(uint8 *data, int pos, uint64 value, int nbits)
+{
+    int     avail, n;
+
+    while (nbits > 0) {
+        avail = 8 - (pos & 7);
+        n = (nbits < avail) ? nbits : avail;
+        data[pos >> 3] |= (uint8)(((value >> (nbits - n)) & ((1 << n) - 1))
+                                   << (avail - n));
+        pos += n;
+        nbits -= n;
+    }
+}
+
+uint64
+unpack_bits(const uint8 *data, int pos, int nbits)
+{
+    uint64  value = 0;
+    int     avail, n;
+
+    while (nbits > 0) {
+        avail = 8 - (pos & 7);
+        n = (nbits < avail) ? nbits : avail;
+        value = (value << n) | ((data[pos >> 3] >> (avail - n)) & ((1 << n) - 1));
+        pos += n;
+        nbits -= n;
+    }
+    return value;
+}
+
+/*
+ * Micro benchmark, SHOW CPU PACKBENCH.
+ *
+ * Each routine is run over a buffer of BENCH_WORDS words at every level
+ * the host supports, after checking that it gives the same bytes or
+ * words as the byte at a time loops the devices used before.
+ */
+
+#define BENCH_WORDS     1024
+#define BENCH_PASSES    2000
+
+static void
+bench_ref_b4(uint8 *data, const uint64 *words, int nwords)
+{
+    int     i;
+
+    for (i = 0; i < nwords; i++) {
+        *data++ = (uint8)((words[i] >> 28) & 0xff);
+        *data++ = (uint8)((words[i] >> 20) & 0xff);
+        *data++ = (uint8)((words[i] >> 12) & 0xff);
+        *data++ = (uint8)((words[i] >> 4) & 0xff);
+    }
+}
+
+static void
+bench_ref_dbd9(uint8 *data, const uint64 *words, int nwords)
+{
+    uint64  temp;
+    int     wp, wc;
+
+    for (wp = wc = 0; wp < nwords;) {
+        temp = words[wp++];
+        data[wc++] = (uint8)((temp >> 28) & 0xff);
+        data[wc++] = (uint8)((temp >> 20) & 0xff);
+        data[wc++] = (uint8)((temp >> 12) & 0xff);
+        data[wc++] = (uint8)((temp >> 4) & 0xff);
+        data[wc] = (uint8)((temp & 0xf) << 4);
+        temp = words[wp++];
+        data[wc++] |= (uint8)((temp >> 32) & 0xf);
+        data[wc++] = (uint8)((temp >> 24) & 0xff);
+        data[wc++] = (uint8)((temp >> 16) & 0xff);
+        data[wc++] = (uint8)((temp >> 8) & 0xff);
+        data[wc++] = (uint8)(temp & 0xff);
+    }
+}
+
+static void
+bench_ref_dld9(uint8 *data, const uint64 *words, int nwords)
+{
+    uint64  temp;
+    int     wp, wc;
+
+    for (wp = wc = 0; wp < nwords;) {
+        temp = words[wp++];
+        data[wc++] = (uint8)(temp & 0xff);
+        data[wc++] = (uint8)((temp >> 8) & 0xff);
+        data[wc++] = (uint8)((temp >> 16) & 0xff);
+        data[wc++] = (uint8)((temp >> 24) & 0xff);
+        data[wc] = (uint8)((temp >> 32)  & 0xf);
+        temp = words[wp++];
+        data[wc++] |= (uint8)((temp << 4) & 0xf0);
+        data[wc++] = (uint8)((temp >> 4) & 0xff);
+        data[wc++] = (uint8)((temp >> 12) & 0xff);
+        data[wc++] = (uint8)((temp >> 20) & 0xff);
+        data[wc++] = (uint8)((temp >> 28) & 0xff);
+    }
+}
+
+struct bench_fmt {
+    const char  *name;
+    int         bpw2;                  /* Bytes per pair of words */
+    uint64      mask;                  /* Bits which survive a round trip */
+    void        (*ref)(uint8 *data, const uint64 *words, int nwords);
+    void        (*pack)(uint8 *data, const uint64 *words, int nwords);
+    void        (*unpack)(uint64 *words, const uint8 *data, int nwords);
+};
+
+static struct bench_fmt bench_fmts[] = {
+    { "B4",   8, FMASK & ~017, &bench_ref_b4,   &pack_b4,   &unpack_b4 },
+    { "DBD9", 9, FMASK,        &bench_ref_dbd9, &pack_dbd9, &unpack_dbd9 },
+    { "DLD9", 9, FMASK,        &bench_ref_dld9, &pack_dld9, &unpack_dld9 },
+    { NULL }
+};
+
+static double
+bench_rate(double start, int words)
+{
+    double  secs = sim_timenow_double() - start;
+
+    return (secs > 0.0) ? (words / secs) / 1000000.0 : 0.0;
+}
+
+t_stat
+pack_show_bench (FILE *st, UNIT *uptr, int32 val, CONST void *desc)
+{
+    static uint64   words[BENCH_WORDS];
+    static uint64   back[BENCH_WORDS];
+    static uint8    ref[BENCH_WORDS * 9 / 2];
+    static uint8    data[BENCH_WORDS * 9 / 2];
+    struct bench_fmt *f;
+    uint64          seed = 0123456701234LL;
+    double          start;
+    int             saved, lvl, i, p, nbytes;
+    t_bool          ok = TRUE;
+
+    for (i = 0; i < BENCH_WORDS; i++) {
+        seed = seed * 6364136223846793005LL + 1442695040888963407LL;
+        words[i] = (seed >> 20) & FMASK;
+    }
+    (void)PACK_LEVEL();
+    saved = pack_use;
+    fprintf(st, "Millions of words per second, %d word buffer\n", BENCH_WORDS);
+    fprintf(st, "%-6s %-8s %10s %10s\n", "Format", "Level", "Pack", "Unpack");
+    for (f = bench_fmts; f->name != NULL; f++) {
+        nbytes = (BENCH_WORDS / 2) * f->bpw2;
+        start = sim_timenow_double();
+        for (p = 0; p < BENCH_PASSES; p++)
+            f->ref(ref, words, BENCH_WORDS);
+        fprintf(st, "%-6s %-8s %10.1f\n", f->name, "byte", bench_rate(start, BENCH_WORDS * BENCH_PASSES));
+        for (lvl = PACK_SCALAR; lvl <= pack_level; lvl++) {
+            double  prate, urate;
+
+            pack_use = lvl;
+            start = sim_timenow_double();
+            for (p = 0; p < BENCH_PASSES; p++)
+                f->pack(data, words, BENCH_WORDS);
+            prate = bench_rate(start, BENCH_WORDS * BENCH_PASSES);
+            start = sim_timenow_double();
+            for (p = 0; p < BENCH_PASSES; p++)
+                f->unpack(back, data, BENCH_WORDS);
+            urate = bench_rate(start, BENCH_WORDS * BENCH_PASSES);
+            if (memcmp(data, ref, nbytes) != 0)
+                ok = FALSE;
+            for (i = 0; i < BENCH_WORDS; i++) {
+                if (back[i] != (words[i] & f->mask))
+                    ok = FALSE;
+            }
+            fprintf(st, "%-6s %-8s %10.1f %10.1f\n", f->name, pack_level_name[lvl], prate, urate);
+            /* Only B4 has vector versions */
+            if (f->pack != &pack_b4)
+                break;
+        }
+        pack_use = saved;
+    }
+    if (!ok) {
+        fprintf(st, "Packed data does not match the byte loops\n");
+        return SCPE_IERR;
+    }
+    return SCPE_OK;
+}
@@ -0,0 +1,54 @@
+/* kx10_pack.h: 36 bit word to byte packing.
+
+   Copyright (c) 2026, the authors
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+   THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+   IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+   CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+/*
+ *  Byte layouts:
+ *
+ *  B4     4 bytes per word, left justified, bits 32-35 unused.
+ *         This is the NIA 20 and Ethernet layout.
+ *
+ *  DBD9   9 bytes per pair of words, big endian.
+ *
+ *  DLD9   9 bytes per pair of words, little endian.
+ *
+ *  See kx10_disk.h for the bit positions of DBD9 and DLD9.
+ */
+
+/* Words to bytes, 4 bytes per word */
+void pack_b4(uint8 *data, const uint64 *words, int nwords);
+/* Bytes to words, 4 bytes per word */
+void unpack_b4(uint64 *words, const uint8 *data, int nwords);
+/* Words to DBD9 bytes, nwords must be even */
+void pack_dbd9(uint8 *data, const uint64 *words, int nwords);
+/* DBD9 bytes to words, nwords must be even */
+void unpack_dbd9(uint64 *words, const uint8 *data, int nwords);
+/* Words to DLD9 bytes, nwords must be even */
+void pack_dld9(uint8 *data, const uint64 *words, int nwords);
+/* DLD9 bytes to words, nwords must be even */
+void unpack_dld9(uint64 *words, const uint8 *data, int nwords);
+/* Or the low nbits of value into a byte stream at bit pos, MSB first */
+void pack_bits(uint8 *data, int pos, uint64 value, int nbits);
+/* Get nbits from a byte stream at bit pos, MSB first */
+uint64 unpack_bits(const uint8 *data, int pos, int nbits);
+/* Time the packing routines */
+t_stat pack_show_bench (FILE *st, UNIT *uptr, int32 val, CONST void *desc);
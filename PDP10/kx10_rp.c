@@ -344,6 +344,12 @@ MTAB                rp_mod[] = {
     {UNIT_DTYPE, (RP06_DTYPE << UNIT_V_DTYPE), "RP06", "RP06", &rp_set_type },
     {UNIT_DTYPE, (RP04_DTYPE << UNIT_V_DTYPE), "RP04", "RP04", &rp_set_type },
     {MTAB_XTD|MTAB_VUN, 0, "FORMAT", "FORMAT", NULL, &disk_show_fmt },
+    {MTAB_XTD|MTAB_VUN|MTAB_VALO, 1, "CACHE", "CACHE", &disk_set_cache, &disk_show_cache,
+              NULL, "Enable sector cache, CACHE=n sets size" },
+    {MTAB_XTD|MTAB_VUN, 0, NULL, "NOCACHE", &disk_set_cache, NULL,
+              NULL, "Disable sector cache" },
+    {MTAB_XTD|MTAB_VUN, 0, NULL, "FLUSH", &disk_set_flush, NULL,
+              NULL, "Write cached sectors to disk" },
     {0}
 };
 
@@ -851,7 +857,13 @@ t_stat rp_svc (UNIT *uptr)
             sim_debug(DEBUG_DETAIL, dptr, "%s%o read (%d,%d,%d)\n", dptr->name, unit, cyl,
                    GET_SF(uptr->DA), GET_SC(uptr->DA));
             da = GET_DA(uptr->DA, dtype);
-            (void)disk_read(uptr, &rp_buf[ctlr][0], da, RP_NUMWD);
+            if (disk_read(uptr, &rp_buf[ctlr][0], da, RP_NUMWD) != SCPE_OK) {
+                uptr->CMD |= (ER1_DCK << 16)|DS_ERR|DS_DRY|DS_ATA;
+                uptr->CMD &= ~CS1_GO;
+                rh_finish_op(rhc, 0);
+                sim_debug(DEBUG_DETAIL, dptr, "%s%o read failed\n", dptr->name, unit);
+                return SCPE_OK;
+            }
             uptr->hwmark = RP_NUMWD;
             uptr->DATAPTR = 0;
             /* On read headers, transfer 2 words to start */
@@ -946,7 +958,13 @@ rd_end:
             sim_debug(DEBUG_DETAIL, dptr, "%s%o write (%d,%d,%d)\n", dptr->name,
                    unit, cyl, GET_SF(uptr->DA), GET_SC(uptr->DA));
             da = GET_DA(uptr->DA, dtype);
-            (void)disk_write(uptr, &rp_buf[ctlr][0], da, RP_NUMWD);
+            if (disk_write(uptr, &rp_buf[ctlr][0], da, RP_NUMWD) != SCPE_OK) {
+                uptr->CMD |= (ER1_OPI << 16)|DS_ERR|DS_DRY|DS_ATA;
+                uptr->CMD &= ~CS1_GO;
+                rh_finish_op(rhc, 0);
+                sim_debug(DEBUG_DETAIL, dptr, "%s%o write failed\n", dptr->name, unit);
+                return SCPE_OK;
+            }
             uptr->DATAPTR = 0;
             CLR_BUF(uptr);
             if (sts) {
@@ -1024,7 +1042,8 @@ rp_boot(int32 unit_num, DEVICE * rptr)
     /* Possible in future find boot loader in FE file system */
     addr = (MEMSIZE - 512) & RMASK;
     for (sect = 4; sect <= 7; sect++) {
-        disk_read(uptr, &rp_buf[0][0], sect, RP_NUMWD);
+        if (disk_read(uptr, &rp_buf[0][0], sect, RP_NUMWD) != SCPE_OK)
+            return SCPE_IOERR;
         ptr = 0;
         for(wc = RP_NUMWD; wc > 0; wc--) {
             word = rp_buf[0][ptr++];
@@ -1033,7 +1052,8 @@ rp_boot(int32 unit_num, DEVICE * rptr)
     }
     word = (MEMSIZE - 512) & RMASK;
 #else
-    disk_read(uptr, &rp_buf[0][0], 0, RP_NUMWD);
+    if (disk_read(uptr, &rp_buf[0][0], 0, RP_NUMWD) != SCPE_OK)
+        return SCPE_IOERR;
     addr = rp_buf[0][ptr] & RMASK;
     wc = (rp_buf[0][ptr++] >> 18) & RMASK;
     while (wc != 0) {
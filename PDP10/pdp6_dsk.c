@@ -273,6 +273,7 @@ dsk_svc (UNIT *uptr)
        if ((dsk_cmd & CMD) == WR_CMD && (uptr->flags & UNIT_WLK) == 0) {
            /* Write the block */
            int da;
+           uint8 *map;
            for (; uptr->DATAPTR < DSK_WDS; uptr->DATAPTR++)
                 dsk_buf[uptr->DATAPTR] = 0;
            cyl = (dsk_addr >> 6) & 01777;
@@ -280,9 +281,19 @@ dsk_svc (UNIT *uptr)
            if (sec > DSK_SECS)
               sec -= DSK_SECS;
            da = (sec + (cyl * DSK_SECS)) * DSK_WDS;
-           err = sim_fseek(uptr->fileref, da * sizeof(uint64), SEEK_SET);
-           (void)sim_fwrite (&dsk_buf[0], sizeof(uint64),
-                        DSK_WDS, uptr->fileref);
+           map = sim_fmap_ptr(uptr, (t_offset)da * sizeof(uint64), sizeof(dsk_buf));
+           if (map != NULL) {
+               /* Mapped image, store straight into it */
+               if (sim_end)
+                   memcpy(map, &dsk_buf[0], sizeof(dsk_buf));
+               else
+                   sim_buf_copy_swapped(map, &dsk_buf[0], sizeof(uint64), DSK_WDS);
+               sim_fmap_dirty(uptr);
+           } else {
+               err = sim_fseek(uptr->fileref, da * sizeof(uint64), SEEK_SET);
+               (void)sim_fwrite (&dsk_buf[0], sizeof(uint64),
+                            DSK_WDS, uptr->fileref);
+           }
            sim_debug(DEBUG_DETAIL, dptr, "DSK %d Write %d %d\n", ctlr, da, cyl);
        }
        uptr->DATAPTR = 0;
@@ -333,14 +344,25 @@ dsk_svc (UNIT *uptr)
        if (dsk_cmd & RD_CMD) {
            /* Read the block */
            int da;
+           uint8 *map;
            cyl = (dsk_addr >> 6) & 01777;
            sec = dsk_addr & 077;
            if (sec > DSK_SECS)
               sec -= DSK_SECS;
            da = (sec + (cyl * DSK_SECS)) * DSK_WDS;
-           err = sim_fseek(uptr->fileref, da * sizeof(uint64), SEEK_SET);
-           wc = sim_fread (&dsk_buf[0], sizeof(uint64),
-                        DSK_WDS, uptr->fileref);
+           map = sim_fmap_ptr(uptr, (t_offset)da * sizeof(uint64), sizeof(dsk_buf));
+           if (map != NULL) {
+               /* Mapped image, no file I/O */
+               if (sim_end)
+                   memcpy(&dsk_buf[0], map, sizeof(dsk_buf));
+               else
+                   sim_buf_copy_swapped(&dsk_buf[0], map, sizeof(uint64), DSK_WDS);
+               wc = DSK_WDS;
+           } else {
+               err = sim_fseek(uptr->fileref, da * sizeof(uint64), SEEK_SET);
+               wc = sim_fread (&dsk_buf[0], sizeof(uint64),
+                            DSK_WDS, uptr->fileref);
+           }
            sim_debug(DEBUG_DETAIL, dptr, "DSK %d Read %d %d\n", ctlr, da, cyl);
            for (; wc < DSK_WDS; wc++)
                 dsk_buf[wc] = 0;
@@ -477,7 +499,8 @@ dsk_attach (UNIT *uptr, CONST char *cptr)
          return r;
      uptr->CUR_CYL = 0;
      uptr->UFLAGS = 0;
-     return SCPE_OK;
+     /* ATTACH -M maps the image, capac is in words */
+     return sim_fmap_attach (uptr, (t_offset)uptr->capac * sizeof(uint64));
 }
 
 /* Device detach */
@@ -496,6 +519,8 @@ dsk_help (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, const char *cptr)
 {
 fprintf (st, "The DSK controller implements the 270 disk controller for the PDP6\n");
 fprintf (st, "Options include the ability to set units write enabled or write locked\n");
+fprintf (st, "ATTACH -M maps the disk image into memory, so blocks are transferred\n");
+fprintf (st, "without file I/O. Changes are written back on detach or SAVE.\n");
 fprint_set_help (st, dptr);
 fprint_show_help (st, dptr);
 fprintf (st, "The DSK device supports the BOOT command.\n");
@@ -104,6 +104,8 @@ CHANP   *find_chanp_ptr(uint16 chsa);               /* find chanp pointer */
 UNIT    *find_unit_ptr(uint16 chsa);                /* find unit pointer */
 int     chan_read_byte(uint16 chsa, uint8 *data);
 int     chan_write_byte(uint16 chsa, uint8 *data);
+int     chan_read_block(uint16 chsa, uint8 *data, int len);
+int     chan_write_block(uint16 chsa, uint8 *data, int len);
 void    set_devattn(uint16 chsa, uint16 flags);
 void    set_devwake(uint16 chsa, uint16 flags);     /* wakeup O/S for async line */
 void    chan_end(uint16 chsa, uint16 flags);
@@ -470,6 +472,7 @@ sim_debug(DEBUG_EXP, &cpu_dev, "writebuff BUFF_CHNEND chp %p chan_byte %04x\n",
         "writebuff WRITE addr %06x DATA %08x status %04x\n",
         addr, chp->chan_buf, chp->chan_status);
     WMB(addr, chp->chan_buf);                       /* write byte to memory */
+    MAPWCK(addr, 1);                                /* reload maps if map list changed */
     return 0;
 }
 
@@ -781,6 +784,137 @@ sim_debug(DEBUG_EXP, &cpu_dev, "chan_write_byte BUFF_CHNEND chp %p chan_byte %04
     return 0;
 }
 
+/* Number of bytes a block transfer can move directly for the current IOCD.
+ * Only plain forward transfers qualify: no error, data left in the IOCD,
+ * no skip or read backward, and the whole run inside memory.  Anything
+ * else, including the end of the IOCD and data chaining, is left to
+ * chan_read_byte/chan_write_byte.  Data tracing also uses the byte path.
+ * Return 0 if the next byte must go the slow way.
+ */
+static int chan_block_len(CHANP *chp, int len)
+{
+    uint32  addr = chp->ccw_addr;
+
+    if (chp->chan_status & STATUS_ERROR)            /* check channel error status */
+        return 0;
+    if (chp->chan_byte == BUFF_CHNEND || chp->ccw_count == 0)
+        return 0;                                   /* end of data or IOCD */
+    if (chp->ccw_flags & FLAG_SKIP)                 /* skipping data */
+        return 0;
+    if ((chp->ccw_cmd & 0xff) == CMD_RDBWD)         /* reading backwards */
+        return 0;
+    if (sim_deb && (cpu_dev.dctrl & DEBUG_DATA))    /* tracing each byte */
+        return 0;
+    if (len > chp->ccw_count)
+        len = chp->ccw_count;                       /* stop at end of IOCD */
+    if (addr > MASK24 || !MEM_ADDR_OK(addr))        /* let byte path post PCHK */
+        return 0;
+    if (len > (int)(MEMSIZE - addr))
+        len = MEMSIZE - addr;                       /* stop at end of memory */
+    return len;
+}
+
+/* read a block of bytes from memory */
+/* write to device */
+/* return number of bytes transferred, if less than len the channel */
+/* has finished, just as if chan_read_byte had returned 1 */
+int chan_read_block(uint16 chsa, uint8 *data, int len)
+{
+    CHANP   *chp = find_chanp_ptr(chsa);            /* get channel prog pointer */
+    int     n = 0;
+    int     cnt;
+    uint32  addr;
+
+    while (n < len) {
+        if ((cnt = chan_block_len(chp, len - n)) != 0) {
+            addr = chp->ccw_addr;
+            chp->ccw_addr += cnt;                   /* next byte address */
+            chp->ccw_count -= cnt;                  /* chars less to process */
+            /* leading bytes, then whole words, then trailing bytes */
+            while (cnt > 0 && (addr & 3) != 0) {
+                data[n++] = RMB(addr);
+                addr++;
+                cnt--;
+            }
+            while (cnt >= 4) {
+                uint32  word = M[addr >> 2];
+
+                data[n++] = (word >> 24) & 0xff;
+                data[n++] = (word >> 16) & 0xff;
+                data[n++] = (word >> 8) & 0xff;
+                data[n++] = word & 0xff;
+                addr += 4;
+                cnt -= 4;
+            }
+            while (cnt > 0) {
+                data[n++] = RMB(addr);
+                addr++;
+                cnt--;
+            }
+            continue;
+        }
+        /* end of IOCD, data chaining or an error, one byte at a time */
+        if (chan_read_byte(chsa, &data[n]))
+            break;
+        n++;
+    }
+    sim_debug(DEBUG_XIO, &cpu_dev,
+        "chan_read_block chsa %04x transferred %04x of %04x addr %06x cnt %04x\n",
+        chsa, n, len, chp->ccw_addr, chp->ccw_count);
+    return n;
+}
+
+/* write a block of bytes to memory */
+/* read from device */
+/* return number of bytes transferred, if less than len the channel */
+/* has finished, just as if chan_write_byte had returned 1 */
+int chan_write_block(uint16 chsa, uint8 *data, int len)
+{
+    CHANP   *chp = find_chanp_ptr(chsa);            /* get channel prog pointer */
+    int     n = 0;
+    int     cnt;
+    uint32  addr;
+
+    while (n < len) {
+        if ((cnt = chan_block_len(chp, len - n)) != 0) {
+            addr = chp->ccw_addr;
+            chp->ccw_addr += cnt;                   /* next byte address */
+            chp->ccw_count -= cnt;                  /* reduce count */
+            chp->chan_byte = BUFF_BUSY;             /* busy, but no data */
+            MAPWCK(addr, (uint32)cnt);              /* reload maps if map list changed */
+            /* leading bytes, then whole words, then trailing bytes */
+            while (cnt > 0 && (addr & 3) != 0) {
+                WMB(addr, data[n]);
+                n++;
+                addr++;
+                cnt--;
+            }
+            while (cnt >= 4) {
+                M[addr >> 2] = ((uint32)data[n] << 24) | ((uint32)data[n+1] << 16) |
+                    ((uint32)data[n+2] << 8) | (uint32)data[n+3];
+                n += 4;
+                addr += 4;
+                cnt -= 4;
+            }
+            while (cnt > 0) {
+                WMB(addr, data[n]);
+                n++;
+                addr++;
+                cnt--;
+            }
+            continue;
+        }
+        /* end of IOCD, data chaining or an error, one byte at a time */
+        if (chan_write_byte(chsa, &data[n]))
+            break;
+        n++;
+    }
+    sim_debug(DEBUG_XIO, &cpu_dev,
+        "chan_write_block chsa %04x transferred %04x of %04x addr %06x cnt %04x\n",
+        chsa, n, len, chp->ccw_addr, chp->ccw_count);
+    return n;
+}
+
 /* post wakeup interrupt for specified async line */
 void set_devwake(uint16 chsa, uint16 flags)
 {
@@ -196,6 +196,13 @@ uint32          BPIX=0;                     /* # pages loaded for O/S */
 uint32          CPIXPL=0;                   /* highest page loaded for User */
 uint32          CPIX=0;                     /* CPIX user MPL offset */
 uint32          HIWM=0;                     /* max maps loaded so far */
+uint32          MCLO=0;                     /* start of O/S map list in map cache */
+uint32          MCHI=0;                     /* end of O/S map list in map cache, 0 if none */
+uint32          MCMPL=0;                    /* MPL address for O/S maps in map cache */
+uint32          MCMAX=0;                    /* map limit for O/S maps in map cache */
+uint32          MAPLD=0;                    /* number of map loads */
+uint32          MAPHIT=0;                   /* O/S map loads found in map cache */
+uint32          MAPFILL=0;                  /* maps filled on first access */
 uint32          TLB[2048];                  /* Translated addresses for each map entry */
 /* bits 0-4 are bits 0-4 from map entry */
 /* bit 0 valid */
@@ -339,6 +346,9 @@ REG cpu_reg[] = {
     {HRDATAD(BPIX, BPIX, 32, "# Maps Loaded for O/S"), REG_FIT},
     {HRDATAD(CPIXPL, CPIXPL, 32, "Maximum Map # Loaded for User"), REG_FIT},
     {HRDATAD(CPIX, CPIX, 32, "Current CPIX user MPL offset"), REG_FIT},
+    {DRDATAD(MAPLD, MAPLD, 32, "Map loads"), REG_FIT},
+    {DRDATAD(MAPHIT, MAPHIT, 32, "O/S map loads from map cache"), REG_FIT},
+    {DRDATAD(MAPFILL, MAPFILL, 32, "Maps filled on first access"), REG_FIT},
     {HRDATAD(CPUSTATUS, CPUSTATUS, 32, "CPU Status Word"), REG_FIT},
     {HRDATAD(TRAPSTATUS, TRAPSTATUS, 32, "TRAP Status Word"), REG_FIT},
     {HRDATAD(CC, CC, 32, "Condition Codes"), REG_FIT},
@@ -401,6 +411,11 @@ MTAB cpu_mod[] = {
     {UNIT_MSIZE, MEMAMOUNT(10),  NULL,  "16M", &cpu_set_size},
     { MTAB_XTD|MTAB_VDV, 0, "IDLE", "IDLE", &sim_set_idle, &sim_show_idle },
     { MTAB_XTD|MTAB_VDV, 0, NULL, "NOIDLE", &sim_clr_idle, NULL },
+    { MTAB_XTD|MTAB_VDV, 0, "FASTIO", "FASTIO", &sim_set_fastio, &sim_show_fastio },
+    { MTAB_XTD|MTAB_VDV, 0, NULL, "NOFASTIO", &sim_clr_fastio, NULL },
+    {MTAB_XTD|MTAB_VDV|MTAB_VALO|MTAB_NMO, 1, "PROFILE", "PROFILE",
+       &sim_set_profile, &sim_show_profile, NULL, "Enable instruction profile, PROFILE=RESET clears counts"},
+    {MTAB_XTD|MTAB_VDV, 0, NULL, "NOPROFILE", &sim_set_profile, NULL, NULL, "Disable instruction profile"},
     {MTAB_XTD | MTAB_VDV | MTAB_NMO | MTAB_SHP, 0, "HISTORY", "HISTORY",
      &cpu_set_hist, &cpu_show_hist},
     {0}
@@ -685,6 +700,21 @@ int base_mode[] = {
 #define MAX256      256     /* 32/27 and 32/87 map limit */
 #define MAX2048     2048    /* 32/67, V6, and V9 map limit */
 
+/* forget the O/S maps held in the map cache */
+/* called when the O/S map list in memory is written */
+void map_cache_inv(void)
+{
+    MCHI = 0;                                       /* reload O/S maps on next load_maps */
+}
+
+/* called after every SCP command */
+/* RESTORE, LOAD and deposits into memory, TLB or MAPC can all */
+/* change what the map cache holds, so drop the O/S maps */
+static void cpu_post_cmd(t_bool from_scp)
+{
+    map_cache_inv();                                /* reload all maps */
+}
+
 /* set up the map registers for the current task in the cpu */
 /* the PSD bpix and cpix are used to setup the maps */
 /* return non-zero if mapping error */
@@ -694,16 +724,22 @@ int base_mode[] = {
 /* The RMR and WMR macros are used to read/write the MAPC cache registers */
 /* RMR(addr) or WMR(addr, data) where addr is a half word alligned address */
 /* We will only get here if the retain maps bit is not set in PSD word 2 */
+/* The O/S maps are the same for every task, so the last O/S map list */
+/* loaded is remembered in MCLO/MCHI and not reloaded if unchanged. */
+/* Writes to the list call map_cache_inv() to force a reload. */
 t_stat load_maps(uint32 thepsd[2], uint32 lmap)
 {
     uint32 num, sdc, spc, onlyos=0;
     uint32 mpl, cpixmsdl, bpixmsdl, msdl, midl;
     uint32 cpix, bpix, i, j, map, osmsdl, osmidl;
     uint32 MAXMAP = MAX2048;                        /* default to 2048 maps */
+    uint32 mchi = MCHI;                             /* non zero if O/S maps in map cache */
 
     sim_debug(DEBUG_TRAP, &cpu_dev,
         "Load Maps Entry PSD %08x %08x STATUS %08x lmap %1x CPU Mode %2x\n",
         thepsd[0], thepsd[1], CPUSTATUS, lmap, CPU_MODEL);
+    MAPLD++;                                        /* count the map loads */
+    MCHI = 0;                                       /* map cache invalid until O/S maps loaded */
 
     /* process 32/7X computers */
     if (CPU_MODEL < MODEL_27) {
@@ -880,6 +916,7 @@ t_stat load_maps(uint32 thepsd[2], uint32 lmap)
         sim_debug(DEBUG_TRAP, &cpu_dev,
             "load_maps MEM SIZE1 %06x mpl %06x invalid\n", MEMSIZE, mpl);
 npmem:
+        MCHI = 0;                                   /* O/S maps no longer in map cache */
         BPIX = 0;                                   /* no os maps loaded */
         CPIXPL = 0;                                 /* no user pages */
         CPIX = cpix;                                /* save user CPIX */
@@ -920,6 +957,7 @@ npmem:
         CPIX = cpix;                                /* save CPIX */
         onlyos = 1;                                 /* flag to only load O/S, nothing else */
         if (osmidl & BIT0) {                        /* see if the O/S retain bit 0 is on */
+            MCHI = mchi;                            /* O/S maps left alone, cache still good */
             return ALLOK;                           /* O/S retain bit is set, no mapping required */
         }
 
@@ -931,6 +969,7 @@ loados: /* merge point for loading O/S first */
                 "load_maps bad O/S page count %04x, map fault\n", spc);
 nomaps:
             /* Bad map load count specified. */
+            MCHI = 0;                               /* O/S maps no longer in map cache */
             BPIX = 0;                               /* no os maps loaded */
             CPIXPL = 0;                             /* no user pages */
             CPIX = cpix;                            /* save CPIX */
@@ -951,8 +990,15 @@ nomaps:
             goto npmem;                             /* non present memory trap */
         }
 
-        /* load the O/S maps */
-        for (j = 0; j < spc; j++, num++) {          /* copy maps from msdl to map cache */
+        /* see if the same O/S maps are still in the map cache */
+        if (mchi && (osmsdl == MCLO) && ((osmsdl + (spc<<1)) == mchi) &&
+            (mpl == MCMPL) && (MAXMAP == MCMAX)) {
+            num = spc;                              /* O/S maps are already loaded */
+            MAPHIT++;                               /* count the map cache hits */
+        }
+
+        /* load the O/S maps, none if found in the map cache */
+        for (j = num; j < spc; j++, num++) {        /* copy maps from msdl to map cache */
             uint32 pad = osmsdl+(j<<1);             /* get page descriptor address */
 
             /* see if map overflow */
@@ -990,6 +1036,12 @@ nomaps:
         }
         BPIX = num;                                 /* save the # maps loaded in O/S */
         CPIXPL = 0;                                 /* no user pages */
+        if (spc != 0) {                             /* remember O/S maps in map cache */
+            MCLO = osmsdl;                          /* start of O/S map list */
+            MCHI = osmsdl + (spc<<1);               /* end of O/S map list */
+            MCMPL = mpl;                            /* MPL they came from */
+            MCMAX = MAXMAP;                         /* and the map limit */
+        }
 
         if (!onlyos)                                /* see if only O/S to be loaded */
             goto loaduser;                          /* no, go load the user maps */
@@ -1007,6 +1059,7 @@ nomaps:
     if (midl & BIT0) {
         /* the user wants the O/S to load first, if the O/S retain bit set? */
         if (osmidl & BIT0) {                        /* see if the O/S retain bit 0 is on */
+            MCHI = mchi;                            /* O/S maps left alone, cache still good */
             num = spc;                              /* yes, set the number of O/S maps loaded */
             BPIX = spc;                             /* save the # maps in O/S */
             goto loaduser;                          /* load user map only or after O/S */
@@ -1164,14 +1217,17 @@ loaduser:
         uint32 pad = msdl+(j<<1);                   /* get page descriptor address */
 
         /* if this is a LPSDCM instruction, just clear the TLB entry */
+        /* the map is loaded from memory by RealAddr on first access */
         if (!lmap) {
-            /* load 16 bit map descriptors */
-            map = RMH(pad);                         /* get page descriptor from memory */
-            if ((num < 0x20) || (num > (spc+BPIX) - 0x10))
+            /* only read the map descriptor when it is to be displayed */
+            if ((cpu_dev.dctrl & DEBUG_DETAIL) &&
+                ((num < 0x20) || (num > (spc+BPIX) - 0x10))) {
+                map = RMH(pad);                     /* get page descriptor from memory */
                 sim_debug(DEBUG_DETAIL, &cpu_dev,
                     "UserV pad %06x=%04x map #%4x, %04x, map2 %08x, TLB %08x, MAPC %08x\n",
                     pad, map, num, map, (((map << 16) & 0xf8000000)|(map & 0x7ff)<<13)|0x04000000,
                     TLB[num], MAPC[num/2]);
+            }
             TLB[num] = 0;                           /* clear the TLB for non valid maps */
             continue;                               /* just clear the TLBs */
         }
@@ -1553,6 +1609,7 @@ t_stat RealAddr(uint32 addr, uint32 *realaddr, uint32 *prot, uint32 access)
     }
 
     /* map is valid, process it */
+    MAPFILL++;                                      /* count maps filled on access */
     TLB[nix] = ((map & 0x7ff) << 13) | ((map << 16) & 0xf8000000) | 0x04000000;
     word = (TLB[nix] & 0xffe000) | offset;          /* combine map and offset */
     WMR((nix<<1), map);                             /* store the map reg contents into MAPC cache */
@@ -1624,6 +1681,7 @@ t_stat RealAddr(uint32 addr, uint32 *realaddr, uint32 *prot, uint32 access)
                     addr, mix, map, nix, TLB[nix], nix/2, MAPC[nix/2]);
 
                 if (map & 0x8000) {                 /* must be valid to load */
+                    MAPFILL++;                      /* count maps filled on access */
                     /* setting access bit fails test 15/0 in vm.mmm diag */
                     TLB[nix] = ((map & 0x7ff) << 13) | ((map << 16) & 0xf8000000) | 0x04000000;
                     word = (TLB[nix] & 0xffe000);   /* combine map and offset */
@@ -1839,6 +1897,7 @@ t_stat Mem_write(uint32 addr, uint32 *data)
             }
         }
         WMW(realaddr, *data);                       /* valid address, put physical address contents */
+        MAPWCK(realaddr, 4);                        /* reload maps if map list changed */
     } else {
         /* RealAddr returned an error */
         sim_debug(DEBUG_TRAP, &cpu_dev,
@@ -2238,6 +2297,7 @@ exec:
 
         opr = (IR >> 16) & MASK16;              /* use upper half of instruction */
         OP = (opr >> 8) & 0xFC;                 /* Get opcode (bits 0-5) left justified */
+        sim_profile (OP, PC);                   /* count instruction if profiling */
         FC =  ((IR & F_BIT) ? 0x4 : 0) | (IR & 3);  /* get F & C bits for addressing */
         reg = (opr >> 7) & 0x7;                 /* dest reg or xr on base mode */
         sreg = (opr >> 4) & 0x7;                /* src reg for reg-reg instructions or BR instr */
@@ -7121,6 +7181,8 @@ t_stat cpu_reset(DEVICE *dptr)
     t_stat  devs = SCPE_OK;
 
     /* leave regs alone so values can be passed to boot code */
+    map_cache_inv();                    /* reload all maps */
+    sim_vm_post = &cpu_post_cmd;        /* and after RESTORE or a deposit */
     PSD1 = 0x80000000;                  /* privileged, non mapped, non extended, address 0 */
     PSD2 = 0x00004000;                  /* blocked interrupts mode */
     modes = (PRIVBIT | BLKMODE);        /* set modes to privileged and blocked interrupts */
@@ -7246,6 +7308,7 @@ t_stat cpu_dep(t_value val, t_addr baddr, UNIT *uptr, int32 sw)
         return SCPE_NXM;                /* no, none existant memory error */
     val = (M[addr] & bmasks[baddr & 0x3]) | (val << (8 * (3 - (baddr & 0x3))));
     M[addr] = val;                      /* set new value */
+    MAPWCK(addr<<2, 4);                 /* reload maps if map list changed */
     return SCPE_OK;                     /* all OK */
 }
 
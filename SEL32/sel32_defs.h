@@ -462,12 +462,26 @@ extern DEBTAB dev_debug[];
 /* write halfword map register to MAP cache address */
 #define WMR(a,d) ((a)&2?(MAPC[(a)>>2]=(MAPC[(a)>>2]&LMASK)|((d)&RMASK)):(MAPC[(a)>>2]=(MAPC[(a)>>2]&RMASK)|((d)<<16)))
 
+/* O/S map list held in the map cache, see load_maps() */
+/* MCLO is the first and MCHI the last+1 byte address, MCHI is 0 if none */
+extern  uint32  MCLO;
+extern  uint32  MCHI;
+extern  void    map_cache_inv(void);
+/* invalidate the map cache if a write of n bytes at address a hits the map list */
+/* Mem_write, channel data transfers and deposits check, but the direct M[] */
+/* stores of the PSD and trap context saves and of channel status (WMW) don't. */
+/* They are assumed never to land in the O/S map list; if one did, the next */
+/* load_maps would reuse the old O/S maps from the map cache. */
+#define MAPWCK(a,n) ((((a) < MCHI) && (((a)+(n)) > MCLO)) ? map_cache_inv() : (void)0)
+
 /* Definitions for commonly used functions */
 extern  t_stat  set_dev_addr(UNIT *uptr, int32 val, CONST char *cptr, void *desc);
 extern  t_stat  show_dev_addr(FILE * st, UNIT *uptr, int32 v, CONST void *desc);
 extern  void    chan_end(uint16 chan, uint16 flags);
 extern  int     chan_read_byte(uint16 chsa, uint8 *data);
 extern  int     chan_write_byte(uint16 chsa, uint8 *data);
+extern  int     chan_read_block(uint16 chsa, uint8 *data, int len);
+extern  int     chan_write_block(uint16 chsa, uint8 *data, int len);
 extern  void    set_devattn(uint16 addr, uint16 flags);
 extern  void    set_devwake(uint16 chsa, uint16 flags);
 extern  t_stat  chan_boot(uint16 addr, DEVICE *dptr);
@@ -395,7 +395,7 @@ t_stat lpr_srv(UNIT *uptr) {
     /* print the line if buffer is full */
     if (uptr->CMDu3 & LPR_FULL || uptr->CBPu6 >= 156) {
         lpr_data[u].lbuff[uptr->CBPu6] = 0x00;  /* NULL terminate */
-        sim_fwrite(&lpr_data[u].lbuff, 1, uptr->CBPu6, uptr->fileref); /* Print our buffer */
+        sim_spool_write(uptr, &lpr_data[u].lbuff, uptr->CBPu6); /* Print our buffer */
         sim_debug(DEBUG_DETAIL, &lpr_dev, "LPR %s", (char*)&lpr_data[u].lbuff);
         uptr->CMDu3 &= ~(LPR_FULL|LPR_CMDMSK);  /* clear old status */
         uptr->CBPu6 = 0;                        /* start at beginning of buffer */
@@ -454,6 +454,7 @@ t_stat lpr_attach(UNIT *uptr, CONST char *file)
 
     if ((r = attach_unit(uptr, file)) != SCPE_OK)
         return r;
+    sim_spool_attach(uptr);                         /* buffer printer output */
     uptr->CMDu3 &= ~(LPR_FULL|LPR_CMDMSK);
     uptr->CNTu4 = 0;
     uptr->SNSu5 = 0;
@@ -745,16 +745,13 @@ rezero:
                 chsa, chp->ccw_count);
 
             /* process the next sector of data */
-            for (i=0; i<len; i++) {
-                ch = buf[i];                    /* get a char from buffer */
-                if (chan_write_byte(chsa, &ch)) {   /* put a byte to memory */
-                    sim_debug(DEBUG_DATA, dptr,
-                        "DISK Read %04x bytes from diskfile /%04x/%02x/%02x tstart %08x\n",
-                        len, cyl, trk, sec, tstart);
-                    uptr->CMD &= ~(0xffff);     /* remove old status bits & cmd */
-                    chan_end(chsa, SNS_CHNEND|SNS_DEVEND);
-                    goto rddone;
-                }
+            if (chan_write_block(chsa, buf, len) != len) {   /* put sector to memory */
+                sim_debug(DEBUG_DATA, dptr,
+                    "DISK Read %04x bytes from diskfile /%04x/%02x/%02x tstart %08x\n",
+                    len, cyl, trk, sec, tstart);
+                uptr->CMD &= ~(0xffff);         /* remove old status bits & cmd */
+                chan_end(chsa, SNS_CHNEND|SNS_DEVEND);
+                goto rddone;
             }
 
             sim_debug(DEBUG_CMD, dptr,
@@ -814,23 +811,18 @@ rddone:
             tstart = STAR2SEC(uptr->CHS, SPT(type), SPC(type));
 
             /* process the next sector of data */
-            len = 0;                            /* used here as a flag for short read */
-            for (i=0; i<ssize; i++) {
-                if (chan_read_byte(chsa, &ch)) {    /* get a byte from memory */
-                    /* if error on reading 1st byte, we are done writing */
-                    if (i == 0) {
-                        uptr->CMD &= ~(0xffff);  /* remove old status bits & cmd */
-                        sim_debug(DEBUG_DATA, dptr,
-                            "DISK Wrote %04x bytes to diskfile cyl %04x hds %02x sec %02x tstart %08x\n",
-                            ssize, cyl, trk, sec, tstart);
-                        chan_end(chsa, SNS_CHNEND|SNS_DEVEND);
-                        goto wrdone;
-                    }
-                    ch = 0;                     /* finish out the sector with zero */
-                    len++;                      /* show we have no more data to write */
-                }
-                buf2[i] = ch;                   /* save the char */
+            i = chan_read_block(chsa, buf2, ssize); /* get the sector from memory */
+            /* if error on reading 1st byte, we are done writing */
+            if (i == 0) {
+                uptr->CMD &= ~(0xffff);         /* remove old status bits & cmd */
+                sim_debug(DEBUG_DATA, dptr,
+                    "DISK Wrote %04x bytes to diskfile cyl %04x hds %02x sec %02x tstart %08x\n",
+                    ssize, cyl, trk, sec, tstart);
+                chan_end(chsa, SNS_CHNEND|SNS_DEVEND);
+                goto wrdone;
             }
+            len = ssize - i;                    /* used here as a flag for short read */
+            memset(&buf2[i], 0, len);           /* finish out the sector with zero */
 
             /* write the sector to disk */
             if ((i=sim_fwrite(buf2, 1, ssize, uptr->fileref)) != ssize) {
@@ -190,6 +190,7 @@ t_stat load_mem (FILE *fileref)
     uint32 data;
     uint32 ma = 0;  /* start at mem add 0 */
 
+    map_cache_inv();                        /* memory changed, reload all maps */
     /* read the file until the end */
     for ( ;; ) {
         if (get_word(fileref, &data))       /* get 32 bits of data */
@@ -76,6 +76,13 @@ static uint32 *colors = NULL;
 static uint32 ncolors = 0, size_colors = 0;
 static uint32 *surface = NULL;
 static uint32 ws_palette[2];                            /* Monochrome palette */
+/*
+ * Region of the surface changed since the last ws_sync, x1 and y1 are
+ * exclusive.  Only this region is handed to sim_video, and nothing at
+ * all when the picture is static.
+ */
+static int dirty_x0, dirty_y0, dirty_x1, dirty_y1;
+static uint32 *dirty_buf = NULL;                        /* Region staging */
 typedef struct cursor {
     Uint8 *data;
     Uint8 *mask;
@@ -395,6 +402,7 @@ ws_init(const char *name, int xp, int yp, int colors, void *dptr)
     ypixels = yp;
     window_name = name;
     surface = (uint32 *)realloc (surface, xpixels*ypixels*sizeof(*surface));
+    dirty_buf = (uint32 *)realloc (dirty_buf, xpixels*ypixels*sizeof(*dirty_buf));
     ret = (0 == vid_open ((DEVICE *)dptr, name, xp*pix_size, yp*pix_size, 0));
     if (ret)
         vid_set_cursor (1, arrow_cursor->width, arrow_cursor->height, arrow_cursor->data, arrow_cursor->mask, arrow_cursor->hot_x, arrow_cursor->hot_y);
@@ -402,6 +410,9 @@ ws_init(const char *name, int xp, int yp, int colors, void *dptr)
     ws_palette[1] = vid_map_rgb (0xFF, 0xFF, 0xFF);     /* white */
     for (i=0; i<xpixels*ypixels; i++)
         surface[i] = ws_palette[0];
+    dirty_x0 = dirty_y0 = 0;                            /* Paint it all once */
+    dirty_x1 = xpixels;
+    dirty_y1 = ypixels;
     return ret;
 }
 
@@ -454,13 +465,32 @@ ws_display_point(int x, int y, void *color)
 {
     uint32 *brush = (uint32 *)color;
 
-    if (x > xpixels || y > ypixels)
+    if (x >= xpixels || y >= ypixels)
         return;
 
     y = ypixels - 1 - y;                /* invert y, top left origin */
 
     if (brush == NULL)
         brush = (uint32 *)ws_color_black ();
+    /* Decay steps often map to the same host color */
+    if (surface[y*xpixels + x] == *brush)
+        return;
+    if (dirty_x1 == dirty_x0) {                         /* First change */
+        dirty_x0 = x;
+        dirty_x1 = x + 1;
+        dirty_y0 = y;
+        dirty_y1 = y + 1;
+        }
+    else {
+        if (x < dirty_x0)
+            dirty_x0 = x;
+        if (x >= dirty_x1)
+            dirty_x1 = x + 1;
+        if (y < dirty_y0)
+            dirty_y0 = y;
+        if (y >= dirty_y1)
+            dirty_y1 = y + 1;
+        }
     if (pix_size > 1) {
         int i, j;
         
@@ -474,7 +504,22 @@ ws_display_point(int x, int y, void *color)
   
 void
 ws_sync(void) {
-    vid_draw (0, 0, xpixels, ypixels, surface);
+    int w = dirty_x1 - dirty_x0;
+    int h = dirty_y1 - dirty_y0;
+
+    if (w == 0)                             /* Nothing changed */
+        return;
+    if (w == xpixels)                       /* Full rows are contiguous */
+        vid_draw (0, dirty_y0, w, h, surface + dirty_y0*xpixels);
+    else {
+        int i;
+
+        for (i=0; i<h; i++)
+            memcpy (dirty_buf + i*w, surface + (dirty_y0 + i)*xpixels + dirty_x0,
+                    w*sizeof(*surface));
+        vid_draw (dirty_x0, dirty_y0, w, h, dirty_buf);
+        }
+    dirty_x0 = dirty_x1 = dirty_y0 = dirty_y1 = 0;
     vid_refresh ();
 }
 
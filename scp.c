@@ -241,6 +241,9 @@
 #endif
 #include <sys/stat.h>
 #include <setjmp.h>
+#if defined(HAVE_ZLIB)
+#include <zlib.h>
+#endif
 
 #if defined(HAVE_DLOPEN)                                /* Dynamic Readline support */
 #include <dlfcn.h>
@@ -269,6 +272,11 @@
 
 #define MAX_DO_NEST_LVL 20                              /* DO cmd nesting level limit */
 #define SRBSIZ          1024                            /* save/restore buffer */
+#define SNAP_CHUNK      4096                            /* save/restore memory chunk */
+#define SNAP_ZERO       0                               /* chunk is all zeroes */
+#define SNAP_SAME       1                               /* chunk unchanged from base */
+#define SNAP_RAW        2                               /* chunk stored as is */
+#define SNAP_ZLIB       3                               /* chunk deflate compressed */
 #define SIM_BRK_INILNT  4096                            /* bpt tbl length */
 #define SIM_BRK_ALLTYP  0xFFFFFFFB
 #define UPDATE_SIM_TIME                                         \
@@ -281,6 +289,7 @@
             _x = sim_clock_queue->time;                         \
         sim_time = sim_time + (_x - sim_interval);              \
         sim_rtime = sim_rtime + ((uint32) (_x - sim_interval)); \
+        sim_clock_qtime = sim_clock_qtime + (_x - sim_interval);\
         if (sim_clock_queue == QUEUE_LIST_END)                  \
             noqueue_time = sim_interval;                        \
         else                                                    \
@@ -370,6 +379,8 @@ int sim_aio_update_queue (void)
 {
 int migrated = 0;
 
+if (!AIO_QUEUE_PENDING)                 /* Nothing queued, skip the lock */
+    return 0;
 AIO_ILOCK;
 if (AIO_QUEUE_VAL != QUEUE_LIST_END) {  /* List !Empty */
     UNIT *q, *uptr;
@@ -469,6 +480,7 @@ t_stat show_cmd_fi (FILE *ofile, int32 flag, CONST char *cptr);
 t_stat show_config (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr);
 t_stat show_queue (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr);
 t_stat show_time (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr);
+t_stat show_benchmark (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr);
 t_stat show_mod_names (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr);
 t_stat show_show_commands (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr);
 t_stat show_log_names (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr);
@@ -492,6 +504,10 @@ t_stat show_one_mod (FILE *st, DEVICE *dptr, UNIT *uptr, MTAB *mptr, CONST char
 t_stat sim_save (FILE *sfile);
 t_stat sim_rest (FILE *rfile);
 
+/* Instruction profile package */
+
+static void sim_profile_start (void);
+
 /* Breakpoint package */
 
 t_stat sim_brk_init (void);
@@ -565,6 +581,8 @@ t_stat set_runlimit (int32 flag, CONST char *cptr);
 t_stat sim_set_asynch (int32 flag, CONST char *cptr);
 static const char *_get_dbg_verb (uint32 dbits, DEVICE* dptr, UNIT *uptr);
 static t_stat sim_sanity_check_register_declarations (void);
+static t_bool _sim_queue_before (UNIT *a, UNIT *b);
+static t_stat sim_queue_test (void);
 static t_stat _sim_debug_flush (void);
 
 /* Global data */
@@ -588,8 +606,13 @@ DEVICE **sim_internal_devices = NULL;
 uint32 sim_internal_device_count = 0;
 int32 sim_opt_out = 0;
 volatile t_bool sim_is_running = FALSE;
+t_bool sim_profile_on = FALSE;
 t_bool sim_processing_event = FALSE;
+static uint32 sim_bench_msec = 0;                       /* host msec spent running */
+static double sim_bench_time = 0.0;                     /* simulated time run */
+static t_uint64 sim_bench_events = 0;                   /* events processed */
 uint32 sim_brk_summ = 0;
+uint32 sim_brk_map[SIM_BRK_MAP_BITS / 32];              /* addresses which may have a breakpoint */
 uint32 sim_brk_types = 0;
 BRKTYPTAB *sim_brk_type_desc = NULL;                /* type descriptions */
 uint32 sim_brk_dflt = 0;
@@ -617,6 +640,11 @@ size_t *sim_sub_instr_off = NULL;   /* offsets in substitution buffer where orig
 static double sim_time;
 static uint32 sim_rtime;
 static int32 noqueue_time;
+static double sim_clock_qtime = 0.0;                    /* event queue base time */
+static t_uint64 sim_clock_qseq = 0;                     /* event queue insertion sequence */
+static UNIT **sim_clock_heap = NULL;                    /* event queue heap (slot 0 unused) */
+static uint32 sim_clock_heap_cnt = 0;                   /* event queue entries */
+static uint32 sim_clock_heap_size = 0;                  /* event queue heap slots allocated */
 volatile t_bool stop_cpu = FALSE;
 volatile t_bool sigterm_received = FALSE;
 static unsigned int sim_stop_sleep_ms = 250;
@@ -743,7 +771,8 @@ const char *sim_savename = sim_name;      /* Simulator Name used in SAVE/RESTORE
 
 /* Tables and strings */
 
-const char save_vercur[] = "V4.0";
+const char save_vercur[] = "V4.1";
+const char save_ver41[] = "V4.1";
 const char save_ver40[] = "V4.0";
 const char save_ver35[] = "V3.5";
 const char save_ver32[] = "V3.2";
@@ -991,6 +1020,10 @@ static const char simh_help1[] =
       " to a file.  This includes the contents of main memory and all registers,\n"
       " and the I/O connections of devices:\n\n"
       "++SAVE <filename>\n\n"
+      "4Switches\n"
+      " Switches can influence the output and behavior of the SAVE command\n\n"
+      "++-I      Only save memory changed since the last SAVE or RESTORE\n"
+      "\n"
 #define HLP_RESTORE     "*Commands Saving_and_Restoring_State RESTORE"
       "3RESTORE\n"
       " The RESTORE command (abbreviation REST, alternately GET) restores a\n"
@@ -1003,10 +1036,16 @@ static const char simh_help1[] =
       "++-F      Overrides the related file timestamp validation check\n"
       "\n"
       "4Notes:\n"
-      " 1) SAVE file format compresses zeroes to minimize file size.\n"
+      " 1) SAVE file format compresses zeroes to minimize file size, and other\n"
+      " memory with zlib when the simulator is built with it.\n"
       " 2) The simulator can't restore active incoming telnet sessions to\n"
       " multiplexer devices, but the listening ports will be restored across a\n"
       " save/restore.\n"
+      " 3) An incremental save (SAVE -I) refers to the file last saved or\n"
+      " restored for unchanged memory.  Restoring it first restores that file,\n"
+      " so it (and any file it in turn refers to) must still exist unchanged.\n"
+      " Keep them in the same directory to be able to move them together.\n"
+      " SAVE won't replace a file the last snapshot saved or restored needs.\n"
        /***************** 80 character line width template *************************/
       "2Running A Simulated Program\n"
 #define HLP_RUN         "*Commands Running_A_Simulated_Program RUN"
@@ -1553,6 +1592,7 @@ static const char simh_help2[] =
       "+sh{ow} on                   show on condition actions\n"
       "+sh{ow} do                   show do nesting state\n"
       "+sh{ow} runlimit             show execution limit states\n"
+      "+sh{ow} benchmark            show execution rates on one line\n"
       "+h{elp} <dev> show           displays the device specific show commands\n"
       "++++++++                     available\n"
 #define HLP_SHOW_CONFIG         "*Commands SHOW"
@@ -1580,6 +1620,7 @@ static const char simh_help2[] =
 #define HLP_SHOW_ON             "*Commands SHOW"
 #define HLP_SHOW_DO             "*Commands SHOW"
 #define HLP_SHOW_RUNLIMIT       "*Commands SHOW"
+#define HLP_SHOW_BENCHMARK      "*Commands SHOW"
 #define HLP_SHOW_SEND           "*Commands SHOW"
 #define HLP_SHOW_EXPECT         "*Commands SHOW"
 #define HLP_HELP                "*Commands HELP"
@@ -2416,11 +2457,12 @@ static const char simh_help2[] =
       "++sim_ether - Ethernet devices\n"
       "++sim_card  - Card Reader/Punch Devices\n"
       "++sim_tmxr  - Terminal Multiplexor Devices\n\n"
-      " The TESTLIB command by itself will invoke library tests for all devices in the\n"
-      " current simulator.\n\n"
+      " The TESTLIB command by itself will invoke the event queue tests and the\n"
+      " library tests for all devices in the current simulator.\n\n"
       " The library tests for a specific device can be invoked by specifying the device\n"
       " name as an argument to the TESTLIB command:\n\n"
-      "++TESTLIB {device}           test a specific or all devices\n\n"
+      "++TESTLIB {device}           test a specific or all devices\n"
+      "++TESTLIB QUEUE              exercise and time the event queue\n\n"
        /***************** 80 character line width template *************************/
       "3Switches\n"
       " Switches can be used to influence the behavior of the TESTLIB command\n\n"
@@ -2600,6 +2642,7 @@ static SHTAB show_glob_tab[] = {
     { "ON",             &show_on,                  -1, HLP_SHOW_ON },
     { "DO",             &show_do,                   0, HLP_SHOW_DO },
     { "RUNLIMIT",       &show_runlimit,             0, HLP_SHOW_RUNLIMIT },
+    { "BENCHMARK",      &show_benchmark,            0, HLP_SHOW_BENCHMARK },
     { NULL,             NULL,                       0 }
     };
 
@@ -6339,6 +6382,16 @@ else if (!flag)
 return SCPE_OK;
 }
 
+static int _sim_queue_compare (const void *pa, const void *pb)
+{
+UNIT *a = *(UNIT * const *)pa;
+UNIT *b = *(UNIT * const *)pb;
+
+if (a == b)
+    return 0;
+return _sim_queue_before (a, b) ? -1 : 1;
+}
+
 t_stat show_queue (FILE *st, DEVICE *dnotused, UNIT *unotused, int32 flag, CONST char *cptr)
 {
 DEVICE *dptr;
@@ -6357,7 +6410,15 @@ else {
 
     fprintf (st, "%s event queue status, time = %.0f, executing %s %s/sec\n",
              sim_name, sim_time, sim_fmt_numeric (inst_per_sec), sim_vm_interval_units);
-    for (uptr = sim_clock_queue; uptr != QUEUE_LIST_END; uptr = uptr->next) {
+    UNIT **sorted = (UNIT **)malloc (sim_clock_heap_cnt * sizeof (*sorted));
+    uint32 i;
+
+    if (sorted == NULL)
+        return SCPE_MEM;
+    memcpy (sorted, &sim_clock_heap[1], sim_clock_heap_cnt * sizeof (*sorted));
+    qsort (sorted, sim_clock_heap_cnt, sizeof (*sorted), _sim_queue_compare);
+    for (i = 0; i < sim_clock_heap_cnt; i++) {
+        uptr = sorted[i];
         if (uptr == &sim_step_unit)
             fprintf (st, "  Step timer");
         else
@@ -6382,6 +6443,7 @@ else {
                                             (*tim) ? " (" : "", tim, (*tim) ? ")" : "",
                                             (uptr->flags & UNIT_IDLE) ? " (Idle capable)" : "");
         }
+    free (sorted);
     }
 sim_show_clock_queues (st, dnotused, unotused, flag, cptr);
 #if defined (SIM_ASYNCH_IO)
@@ -6419,6 +6481,36 @@ fprintf (st, "Time:\t%.0f\n", sim_gtime());
 return SCPE_OK;
 }
 
+/* Show host execution rates since the simulator started, one line of
+   name=value pairs so that benchmark scripts can collect them */
+
+t_stat show_benchmark (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr)
+{
+const char *name = sim_prog_name ? sim_prog_name : "";
+const char *p;
+double secs = sim_bench_msec / 1000.0;
+#if defined(SIM_ASYNCH_IO)
+const char *aio = sim_asynch_enabled ? "on" : "off";
+#else
+const char *aio = "none";                               /* not built in */
+#endif
+
+if (cptr && (*cptr != 0))
+    return SCPE_2MARG;
+for (p = name; *p; p++)                                 /* strip directory */
+    if ((*p == '/') || (*p == '\\') || (*p == ':') || (*p == ']'))
+        name = p + 1;
+fprintf (st, "BENCHMARK sim=%.*s units=%s msec=%u count=%.0f events=%" LL_FMT "u io_ops=%" LL_FMT "u aio=%s",
+         (int)(strcspn (name, ".")), name, sim_vm_interval_units, sim_bench_msec,
+         sim_bench_time, sim_bench_events, sim_fio_ops, aio);
+if (secs > 0.0)
+    fprintf (st, " %s_per_sec=%.0f events_per_sec=%.0f io_ops_per_sec=%.0f",
+             sim_vm_interval_units, sim_bench_time / secs,
+             sim_bench_events / secs, sim_fio_ops / secs);
+fprintf (st, "\n");
+return SCPE_OK;
+}
+
 t_stat show_break (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr)
 {
 t_stat r;
@@ -7681,6 +7773,8 @@ if (!(uptr->flags & UNIT_ATT)) {                        /* not attached? */
     else
         return SCPE_UNATT;                              /* complain */
     }
+sim_fmap_detach (uptr);                                 /* write back and unmap */
+sim_spool_detach (uptr);                                /* write out printer spool */
 if ((dptr = find_dev_from_unit (uptr)) == NULL)
     return SCPE_OK;
 if ((uptr->flags & UNIT_BUF) && (uptr->filebuf)) {
@@ -7813,9 +7907,364 @@ return uptr->uname = strcpy ((char *)malloc (1 + strlen (uname)), uname);
 }
 
 
+/* Memory snapshots
+
+   Memory is saved in chunks of SNAP_CHUNK words.  A chunk is written as
+   its word count and kind, followed for SNAP_RAW by its data and for
+   SNAP_ZLIB by the compressed length and the deflated data.  Data is
+   always stored little endian.
+
+   For every memory unit the hash of each chunk as it was last saved or
+   restored is kept.  An incremental save (SAVE -I) names the last snapshot
+   file saved or restored as its base and writes chunks whose hash did not
+   change as SNAP_SAME.  Restoring an incremental snapshot first restores
+   its base (and so on down the chain) and then applies the chunks which
+   changed.  Since the hashes are taken from the memory contents, memory
+   changed by any path (CPU, DMA, DEPOSIT or LOAD) is seen.
+
+   The base is recorded as the hash of its whole file followed by its
+   name, relative to the incremental file when both are in the same
+   directory and as a full path otherwise.  RESTORE refuses a base whose
+   contents no longer match, and SAVE refuses to replace any file the last
+   snapshot saved or restored depends on.
+*/
+
+typedef struct {
+    UNIT                *uptr;                          /* memory unit */
+    t_addr              capac;                          /* size when hashed */
+    uint32              chunks;                         /* number of chunks */
+    t_bool              valid;                          /* hashes match last snapshot */
+    t_uint64            *sum;                           /* chunk hashes */
+    } SNAP_MEM;
+
+static SNAP_MEM *sim_snap_mem = NULL;                   /* memory units seen */
+static uint32 sim_snap_mem_count = 0;
+static char **sim_snap_chain = NULL;                    /* full paths of the last snapshot */
+static int32 sim_snap_chain_count = 0;                  /* (last entry) and its bases */
+static t_uint64 sim_snap_id = 0;                        /* file hash of the last snapshot */
+static char *sim_snap_ref = NULL;                       /* base name written by SAVE -I */
+static char *sim_snap_file = NULL;                      /* snapshot being restored */
+static int32 sim_snap_depth = 0;                        /* base restore nesting level */
+static t_bool sim_snap_tracked = FALSE;                 /* restored file has chunk hashes */
+
+#define SNAP_MAX_DEPTH  64                              /* longest incremental chain */
+
+#define WRITE_I(xx) sim_fwrite (&(xx), sizeof (xx), 1, sfile)
+
+static SNAP_MEM *_sim_snap_unit (UNIT *uptr, t_addr capac, uint32 chunks)
+{
+SNAP_MEM *sm;
+uint32 i;
+
+for (i = 0; i < sim_snap_mem_count; i++)
+    if (sim_snap_mem[i].uptr == uptr)
+        break;
+if (i == sim_snap_mem_count) {                          /* new unit? */
+    sm = (SNAP_MEM *)realloc (sim_snap_mem, (i + 1) * sizeof (*sm));
+    if (sm == NULL)
+        return NULL;
+    sim_snap_mem = sm;
+    ++sim_snap_mem_count;
+    memset (&sim_snap_mem[i], 0, sizeof (*sm));
+    sim_snap_mem[i].uptr = uptr;
+    }
+sm = &sim_snap_mem[i];
+if ((sm->sum == NULL) || (sm->capac != capac) || (sm->chunks != chunks)) {
+    free (sm->sum);                                     /* size changed */
+    sm->sum = (t_uint64 *)calloc (chunks ? chunks : 1, sizeof (*sm->sum));
+    if (sm->sum == NULL)
+        return NULL;
+    sm->capac = capac;
+    sm->chunks = chunks;
+    sm->valid = FALSE;
+    }
+return sm;
+}
+
+/* 64 bit FNV-1a hash of a chunk */
+
+static t_uint64 _sim_snap_hash_add (t_uint64 h, const void *buf, size_t len)
+{
+const uint8 *p = (const uint8 *)buf;
+const t_uint64 prime = (((t_uint64)0x100) << 32) | 0x1B3;
+
+while (len--)
+    h = (h ^ *p++) * prime;
+return h;
+}
+
+static t_uint64 _sim_snap_hash (const void *buf, size_t len)
+{
+return _sim_snap_hash_add ((((t_uint64)0xCBF29CE4) << 32) | 0x84222325, buf, len);
+}
+
+/* Hash of a whole snapshot file, identifies the base of SAVE -I */
+
+static t_stat _sim_snap_file_id (FILE *f, t_uint64 *id)
+{
+uint8 buf[8192];
+size_t n;
+t_uint64 h = _sim_snap_hash (NULL, 0);
+
+rewind (f);
+while ((n = fread (buf, 1, sizeof (buf), f)) > 0)
+    h = _sim_snap_hash_add (h, buf, n);
+*id = h;
+if (ferror (f))
+    return SCPE_IOERR;
+rewind (f);
+return SCPE_OK;
+}
+
+/* Snapshot chain, the files the last snapshot needs to be restored */
+
+static void _sim_snap_chain_clear (void)
+{
+while (sim_snap_chain_count > 0)
+    free (sim_snap_chain[--sim_snap_chain_count]);
+free (sim_snap_chain);
+sim_snap_chain = NULL;
+}
+
+static void _sim_snap_chain_add (const char *path)
+{
+char **chain = (char **)realloc (sim_snap_chain, (sim_snap_chain_count + 1) * sizeof (*chain));
+char *name = (char *)malloc (1 + strlen (path));
+
+if ((chain == NULL) || (name == NULL)) {                /* can't track it? */
+    if (chain != NULL)
+        sim_snap_chain = chain;
+    free (name);
+    _sim_snap_chain_clear ();                           /* then no SAVE -I */
+    return;
+    }
+sim_snap_chain = chain;
+sim_snap_chain[sim_snap_chain_count++] = strcpy (name, path);
+}
+
+static t_bool _sim_snap_in_chain (const char *path, t_bool with_last)
+{
+int32 i;
+int32 n = sim_snap_chain_count - (with_last ? 0 : 1);
+
+for (i = 0; i < n; i++)
+    if (strcmp (path, sim_snap_chain[i]) == 0)
+        return TRUE;
+return FALSE;
+}
+
+/* Base name to store in an incremental snapshot file */
+
+static char *_sim_snap_ref (const char *file, const char *base)
+{
+char *fdir = sim_filepath_parts (file, "p");
+char *bdir = sim_filepath_parts (base, "p");
+char *ref;
+
+if ((fdir != NULL) && (bdir != NULL) && (strcmp (fdir, bdir) == 0))
+    ref = sim_filepath_parts (base, "nx");              /* same directory */
+else
+    ref = sim_filepath_parts (base, "f");
+free (fdir);
+free (bdir);
+return ref;
+}
+
+/* Full path of a base named in the snapshot being restored */
+
+static char *_sim_snap_resolve (const char *ref)
+{
+char *dir, *path, *full;
+
+if ((ref[0] == '/') || (ref[0] == '\\') || (ref[0] && (ref[1] == ':')) ||
+    (sim_snap_file == NULL))
+    return sim_filepath_parts (ref, "f");
+if ((dir = sim_filepath_parts (sim_snap_file, "p")) == NULL)
+    return NULL;
+path = (char *)malloc (1 + strlen (dir) + strlen (ref));
+if (path == NULL) {
+    free (dir);
+    return NULL;
+    }
+sprintf (path, "%s%s", dir, ref);
+full = sim_filepath_parts (path, "f");
+free (dir);
+free (path);
+return full;
+}
+
+static uint32 _sim_snap_chunks (DEVICE *dptr, t_addr high)
+{
+t_addr words = (high + dptr->aincr - 1) / dptr->aincr;
+
+return (uint32)((words + SNAP_CHUNK - 1) / SNAP_CHUNK);
+}
+
+static t_stat _sim_snap_save_mem (FILE *sfile, DEVICE *dptr, UNIT *uptr, t_addr high, t_bool incremental)
+{
+size_t sz = SZ_D (dptr);
+size_t zsize = SNAP_CHUNK * sz;
+SNAP_MEM *sm = _sim_snap_unit (uptr, high, _sim_snap_chunks (dptr, high));
+void *mbuf = calloc (SNAP_CHUNK, sz);
+uint8 *zbuf;
+uint8 *data;
+uint32 c, len;
+int32 l, kind;
+t_addr k;
+t_value val;
+t_uint64 sum;
+t_bool zeroflg;
+t_stat r = SCPE_OK;
+
+#if defined(HAVE_ZLIB)
+zsize = compressBound ((uLong)zsize);
+#endif
+zbuf = (uint8 *)malloc (zsize);
+if ((sm == NULL) || (mbuf == NULL) || (zbuf == NULL)) {
+    free (mbuf);
+    free (zbuf);
+    return SCPE_MEM;
+    }
+incremental = incremental && sm->valid;                 /* base has these chunks? */
+sm->valid = FALSE;
+for (k = 0, c = 0; k < high; c++) {                     /* loop thru chunks */
+    zeroflg = TRUE;
+    for (l = 0; (l < SNAP_CHUNK) && (k < high); l++,
+         k = k + (dptr->aincr)) {
+        r = dptr->examine (&val, k, uptr, SIM_SW_REST);
+        if (r != SCPE_OK)
+            break;
+        if (val)
+            zeroflg = FALSE;
+        SZ_STORE (sz, val, mbuf, l);
+        }
+    if (r != SCPE_OK)
+        break;
+    len = (uint32)(l * sz);
+    sum = _sim_snap_hash (mbuf, len);
+    data = (uint8 *)mbuf;
+    if (zeroflg)                                        /* all zero's? */
+        kind = SNAP_ZERO;
+    else if (incremental && (sm->sum[c] == sum))        /* unchanged? */
+        kind = SNAP_SAME;
+    else {
+        kind = SNAP_RAW;
+        if (!sim_end)                                   /* stored little endian */
+            sim_buf_swap_data (mbuf, sz, l);
+#if defined(HAVE_ZLIB)
+        if (1) {
+            uLongf zlen = (uLongf)zsize;
+
+            if ((compress2 (zbuf, &zlen, (Bytef *)mbuf, (uLong)len, Z_BEST_SPEED) == Z_OK) &&
+                (zlen < len)) {
+                kind = SNAP_ZLIB;
+                len = (uint32)zlen;
+                data = zbuf;
+                }
+            }
+#endif
+        }
+    sm->sum[c] = sum;
+    WRITE_I (l);                                        /* word count */
+    WRITE_I (kind);                                     /* chunk kind */
+    if (kind == SNAP_ZLIB)
+        WRITE_I (len);                                  /* compressed length */
+    if ((kind == SNAP_RAW) || (kind == SNAP_ZLIB))
+        sim_fwrite (data, 1, len, sfile);
+    }
+sm->valid = (r == SCPE_OK);
+free (mbuf);
+free (zbuf);
+return r;
+}
+
+static t_stat _sim_snap_rest_mem (FILE *rfile, DEVICE *dptr, UNIT *uptr, t_addr high)
+{
+size_t sz = SZ_D (dptr);
+size_t zsize = SNAP_CHUNK * sz;
+SNAP_MEM *sm = _sim_snap_unit (uptr, high, _sim_snap_chunks (dptr, high));
+void *mbuf = calloc (SNAP_CHUNK, sz);
+uint8 *zbuf = (uint8 *)malloc (zsize);
+uint32 c, len;
+int32 j, l, kind;
+t_addr k;
+t_value val;
+t_stat r = SCPE_OK;
+
+if ((sm == NULL) || (mbuf == NULL) || (zbuf == NULL)) {
+    free (mbuf);
+    free (zbuf);
+    return SCPE_MEM;
+    }
+for (k = 0, c = 0; (k < high) && (r == SCPE_OK); c++) { /* loop thru chunks */
+    if ((c >= sm->chunks) ||
+        (sim_fread (&l, sizeof (l), 1, rfile) == 0) ||
+        (sim_fread (&kind, sizeof (kind), 1, rfile) == 0) ||
+        (l <= 0) || (l > SNAP_CHUNK)) {
+        r = SCPE_IOERR;
+        break;
+        }
+    len = (uint32)(l * sz);
+    switch (kind) {
+        case SNAP_SAME:                                 /* as left by base */
+            if (!sm->valid)
+                r = SCPE_INCOMP;
+            k = k + l * dptr->aincr;
+            continue;
+        case SNAP_ZERO:
+            memset (mbuf, 0, len);
+            break;
+        case SNAP_RAW:
+            if (sim_fread (mbuf, 1, len, rfile) != len)
+                r = SCPE_IOERR;
+            break;
+        case SNAP_ZLIB:
+            if ((sim_fread (&len, sizeof (len), 1, rfile) == 0) ||
+                (len > zsize) ||
+                (sim_fread (zbuf, 1, len, rfile) != len)) {
+                r = SCPE_IOERR;
+                break;
+                }
+#if defined(HAVE_ZLIB)
+            if (1) {
+                uLongf mlen = (uLongf)(l * sz);
+
+                if ((uncompress ((Bytef *)mbuf, &mlen, zbuf, (uLong)len) != Z_OK) ||
+                    (mlen != (uLongf)(l * sz)))
+                    r = SCPE_IOERR;
+                }
+#else
+            r = sim_messagef (SCPE_INCOMP, "Compressed memory can't be restored without zlib support\n");
+#endif
+            len = (uint32)(l * sz);
+            break;
+        default:
+            r = SCPE_IOERR;
+            break;
+        }
+    if (r != SCPE_OK)
+        break;
+    if ((kind != SNAP_ZERO) && !sim_end)                /* stored little endian */
+        sim_buf_swap_data (mbuf, sz, l);
+    sm->sum[c] = _sim_snap_hash (mbuf, len);
+    for (j = 0; j < l; j++, k = k + (dptr->aincr)) {
+        SZ_LOAD (sz, val, mbuf, j);
+        r = dptr->deposit (val, k, uptr, SIM_SW_REST);
+        if (r != SCPE_OK)
+            break;
+        }
+    }
+sm->valid = (r == SCPE_OK);
+free (mbuf);
+free (zbuf);
+return r;
+}
+
 /* Save command
 
    sa[ve] filename              save state to specified file
+   sa[ve] -i filename           save only memory changed since the last
+                                snapshot saved or restored
 */
 
 t_stat save_cmd (int32 flag, CONST char *cptr)
@@ -7823,6 +8272,8 @@ t_stat save_cmd (int32 flag, CONST char *cptr)
 FILE *sfile;
 t_stat r;
 char gbuf[4*CBUFSIZE];
+char *path;
+t_bool incremental;
 
 GET_SWITCHES (cptr);                                    /* get switches */
 if (*cptr == 0)                                         /* must be more */
@@ -7830,30 +8281,65 @@ if (*cptr == 0)                                         /* must be more */
 gbuf[sizeof(gbuf)-1] = '\0';
 strlcpy (gbuf, cptr, sizeof(gbuf));
 sim_trim_endspc (gbuf);
+incremental = ((sim_switches & SWMASK ('I')) != 0);
+if (incremental && (sim_snap_chain_count == 0))
+    return sim_messagef (SCPE_ARG, "No previous SAVE or RESTORE to save changes against\n");
+if ((path = sim_filepath_parts (gbuf, "f")) == NULL)
+    return SCPE_MEM;
+if (_sim_snap_in_chain (path, incremental)) {           /* would break the chain? */
+    free (path);
+    return sim_messagef (SCPE_ARG, "Can't replace %s, the last snapshot saved or restored depends on it\n", gbuf);
+    }
+if (incremental) {
+    const char *base = sim_snap_chain[sim_snap_chain_count - 1];
+    FILE *bfile = sim_fopen (base, "rb");
+    t_uint64 id = 0;
+
+    r = (bfile != NULL) ? _sim_snap_file_id (bfile, &id) : SCPE_OPENERR;
+    if (bfile != NULL)
+        fclose (bfile);
+    if ((r != SCPE_OK) || (id != sim_snap_id)) {        /* changed behind our back? */
+        free (path);
+        return sim_messagef (SCPE_INCOMP, "Base snapshot %s has changed since it was saved or restored\n", base);
+        }
+    if ((sim_snap_ref = _sim_snap_ref (path, base)) == NULL) {
+        free (path);
+        return SCPE_MEM;
+        }
+    }
 if ((sfile = sim_fopen (gbuf, "r+b")) == NULL) {    /* try existing file */
-    if ((sfile = sim_fopen (gbuf, "wb")) == NULL)   /* create new empty file */
+    if ((sfile = sim_fopen (gbuf, "w+b")) == NULL) {/* create new empty file */
+        free (sim_snap_ref);
+        sim_snap_ref = NULL;
+        free (path);
         return SCPE_OPENERR;
+        }
     }
 r = sim_save (sfile);
+free (sim_snap_ref);
+sim_snap_ref = NULL;
+if (r == SCPE_OK)                                       /* identify it for SAVE -I */
+    r = (fflush (sfile) == 0) ? _sim_snap_file_id (sfile, &sim_snap_id) : SCPE_IOERR;
 fclose (sfile);
+if ((r != SCPE_OK) || !incremental)                     /* new chain */
+    _sim_snap_chain_clear ();
+if (r == SCPE_OK)
+    _sim_snap_chain_add (path);
+free (path);
 return r;
 }
 
 t_stat sim_save (FILE *sfile)
 {
-void *mbuf;
-int32 l, t;
+int32 t;
 uint32 i, j, device_count;
-t_addr k, high;
+t_addr high;
 t_value val;
 t_stat r;
-t_bool zeroflg;
-size_t sz;
 DEVICE *dptr;
 UNIT *uptr;
 REG *rptr;
-
-#define WRITE_I(xx) sim_fwrite (&(xx), sizeof (xx), 1, sfile)
+t_bool incremental = (sim_snap_ref != NULL);
 
 /* Don't make changes below without also changing save_vercur above */
 
@@ -7872,6 +8358,10 @@ fprintf (sfile, "git commit id: %8.8s\n", S_xstr(SIM_GIT_COMMIT_ID));
 #else
 fprintf (sfile, "git commit id: unknown\n");
 #endif
+if (incremental)                                        /* [V4.1] base snapshot */
+    fprintf (sfile, "%016" LL_FMT "X %s\n", sim_snap_id, sim_snap_ref);
+else
+    fprintf (sfile, "\n");
 
 for (device_count = 0; sim_devices[device_count]; device_count++);/* count devices */
 for (i = 0; i < (device_count + sim_internal_device_count); i++) {/* loop thru devices */
@@ -7907,6 +8397,9 @@ for (i = 0; i < (device_count + sim_internal_device_count); i++) {/* loop thru d
         WRITE_I (uptr->pos);
         if (uptr->flags & UNIT_ATT) {
             fputs (uptr->filename, sfile);
+            if (uptr->io_flush)                         /* write back device */
+                uptr->io_flush (uptr);                  /* held data */
+            sim_fmap_sync (uptr);                       /* mapped files written too */
             if ((uptr->flags & UNIT_BUF) &&             /* writable buffered */
                 uptr->hwmark &&                         /* files need to be */
                 ((uptr->flags & UNIT_RO) == 0)) {       /* written on save */
@@ -7922,33 +8415,9 @@ for (i = 0; i < (device_count + sim_internal_device_count); i++) {/* loop thru d
              (dptr->examine != NULL) &&
              ((high = uptr->capac) != 0)) {             /* memory-like unit? */
             WRITE_I (high);                             /* [V2.5] write size */
-            sz = SZ_D (dptr);
-            if ((mbuf = calloc (SRBSIZ, sz)) == NULL) {
-                fclose (sfile);
-                return SCPE_MEM;
-                }
-            for (k = 0; k < high; ) {                   /* loop thru mem */
-                zeroflg = TRUE;
-                for (l = 0; (l < SRBSIZ) && (k < high); l++,
-                     k = k + (dptr->aincr)) {           /* check for 0 block */
-                    r = dptr->examine (&val, k, uptr, SIM_SW_REST);
-                    if (r != SCPE_OK) {
-                        free (mbuf);
-                        return r;
-                        }
-                    if (val) zeroflg = FALSE;
-                    SZ_STORE (sz, val, mbuf, l);
-                    }                                   /* end for l */
-                if (zeroflg) {                          /* all zero's? */
-                    l = -l;                             /* invert block count */
-                    WRITE_I (l);                        /* write only count */
-                    }
-                else {
-                    WRITE_I (l);                        /* block count */
-                    sim_fwrite (mbuf, sz, l, sfile);
-                    }
-                }                                       /* end for k */
-            free (mbuf);                                /* dealloc buffer */
+            r = _sim_snap_save_mem (sfile, dptr, uptr, high, incremental);/* [V4.1] chunks */
+            if (r != SCPE_OK)
+                return r;
             }                                           /* end if mem */
         else {                                          /* no memory */
             high = 0;                                   /* write 0 */
@@ -7990,6 +8459,7 @@ t_stat restore_cmd (int32 flag, CONST char *cptr)
 FILE *rfile;
 t_stat r;
 char gbuf[4*CBUFSIZE];
+char *path;
 
 GET_SWITCHES (cptr);                                    /* get switches */
 if (*cptr == 0)                                         /* must be more */
@@ -7999,8 +8469,22 @@ strlcpy (gbuf, cptr, sizeof(gbuf));
 sim_trim_endspc (gbuf);
 if ((rfile = sim_fopen (gbuf, "rb")) == NULL)
     return SCPE_OPENERR;
+if ((path = sim_filepath_parts (gbuf, "f")) == NULL) {
+    fclose (rfile);
+    return SCPE_MEM;
+    }
+_sim_snap_chain_clear ();                               /* bases get added */
+sim_snap_tracked = FALSE;
+sim_snap_file = path;
 r = sim_rest (rfile);
+sim_snap_file = NULL;
+if ((r == SCPE_OK) && sim_snap_tracked &&               /* new base for changes? */
+    (_sim_snap_file_id (rfile, &sim_snap_id) == SCPE_OK))
+    _sim_snap_chain_add (path);
+else
+    _sim_snap_chain_clear ();
 fclose (rfile);
+free (path);
 return r;
 }
 
@@ -8018,7 +8502,7 @@ t_addr k, high, old_capac;
 t_value val, mask;
 t_stat r;
 size_t sz;
-t_bool v40, v35, v32;
+t_bool v41, v40, v35, v32;
 DEVICE *dptr;
 UNIT *uptr;
 REG *rptr;
@@ -8043,8 +8527,10 @@ if (fstat (fileno (rfile), &rstat)) {
     goto Cleanup_Return;
     }
 READ_S (buf);                                           /* [V2.5+] read version */
-v40 = v35 = v32 = FALSE;
-if (strcmp (buf, save_ver40) == 0)                      /* version 4.0? */
+v41 = v40 = v35 = v32 = FALSE;
+if (strcmp (buf, save_ver41) == 0)                      /* version 4.1? */
+    v41 = v40 = v35 = v32 = TRUE;
+else if (strcmp (buf, save_ver40) == 0)                 /* version 4.0? */
     v40 = v35 = v32 = TRUE;
 else if (strcmp (buf, save_ver35) == 0)                 /* version 3.5? */
     v35 = v32 = TRUE;
@@ -8054,7 +8540,8 @@ else if (strcmp (buf, save_ver30) != 0) {               /* version 3.0? */
     sim_printf ("Invalid file version: %s\n", buf);
     return SCPE_INCOMP;
     }
-if ((strcmp (buf, save_ver40) != 0) && (!sim_quiet) && (!suppress_warning)) {
+sim_snap_tracked = v41;                                 /* chunk hashes restored? */
+if ((!v40) && (!sim_quiet) && (!suppress_warning)) {
     sim_printf ("warning - attempting to restore a saved simulator image in %s image format.\n", buf);
     warned = TRUE;
     }
@@ -8096,6 +8583,58 @@ if (v40) {
 #undef S_xstr
 #endif
     }
+if (v41) {
+    READ_S (buf);                                       /* [V4.1] base snapshot */
+    if (buf[0] != '\0') {                               /* incremental? */
+        FILE *bfile;
+        char *bpath;
+        char *file = sim_snap_file;
+        t_uint64 id, bid;
+
+        if ((strlen (buf) < 18) || (buf[16] != ' ') ||  /* base hash and name */
+            (sscanf (buf, "%16" LL_FMT "X", &id) != 1)) {
+            sim_printf ("Invalid base snapshot: %s\n", buf);
+            r = SCPE_INCOMP;
+            goto Cleanup_Return;
+            }
+        if (sim_snap_depth >= SNAP_MAX_DEPTH) {
+            sim_printf ("Too many incremental snapshots based on: %s\n", buf + 17);
+            r = SCPE_INCOMP;
+            goto Cleanup_Return;
+            }
+        if ((bpath = _sim_snap_resolve (buf + 17)) == NULL) {
+            r = SCPE_MEM;
+            goto Cleanup_Return;
+            }
+        if ((bfile = sim_fopen (bpath, "rb")) == NULL) {
+            sim_printf ("Can't open base snapshot: %s\n", bpath);
+            free (bpath);
+            r = SCPE_OPENERR;
+            goto Cleanup_Return;
+            }
+        if ((_sim_snap_file_id (bfile, &bid) != SCPE_OK) || (bid != id)) {
+            sim_printf ("Base snapshot %s has changed since this snapshot was saved\n", bpath);
+            fclose (bfile);
+            free (bpath);
+            r = SCPE_INCOMP;
+            goto Cleanup_Return;
+            }
+        ++sim_snap_depth;                               /* restore base first */
+        sim_snap_file = bpath;
+        sim_switches = SWMASK ('D') | SWMASK ('F') | SWMASK ('Q');
+        r = sim_rest (bfile);
+        sim_snap_file = file;
+        --sim_snap_depth;
+        fclose (bfile);
+        if (r != SCPE_OK) {
+            sim_printf ("Error restoring base snapshot: %s\n", bpath);
+            free (bpath);
+            goto Cleanup_Return;
+            }
+        _sim_snap_chain_add (bpath);                    /* depends on it too */
+        free (bpath);
+        }
+    }
 if (!dont_detach_attach)
     detach_all (0, 0);                                  /* Detach everything to start from a consistent state */
 else {
@@ -8227,6 +8766,12 @@ for ( ;; ) {                                            /* device loop */
                     fprint_capac (sim_log, dptr, uptr);
                 sim_printf ("\n");
                 }
+            if (v41) {                                  /* [V4.1+] chunks */
+                r = _sim_snap_rest_mem (rfile, dptr, uptr, high);
+                if (r != SCPE_OK)
+                    goto Cleanup_Return;
+                continue;
+                }
             sz = SZ_D (dptr);                           /* allocate buffer */
             if ((mbuf = calloc (SRBSIZ, sz)) == NULL) {
                 r = SCPE_MEM;
@@ -8359,6 +8904,8 @@ for (i = 1; (dptr = sim_devices[i]) != NULL; i++) {     /* flush attached files
                     !sim_is_running)
                     uptr->io_flush (uptr);              /* call it */
                 }
+            else if (uptr->spool)                       /* printer spool? */
+                sim_spool_flush (uptr);                 /* write it out */
             else {
                 if (!(uptr->flags & UNIT_BUF) &&        /* not buffered, */
                     (uptr->fileref) &&                  /* real file, */
@@ -8407,6 +8954,8 @@ t_value pcv, orig_pcv;
 t_stat r;
 DEVICE *dptr;
 UNIT *uptr;
+uint32 bench_msec;
+double bench_time;
 
 if (sim_runlimit_enabled &&                             /* If the run limit has been hit? */
     (!sim_is_active (&sim_runlimit_unit))) {
@@ -8579,10 +9128,13 @@ if (sim_log)                                            /* flush log if enabled
     fflush (sim_log);
 sim_throt_sched ();                                     /* set throttle */
 sim_start_timer_services ();                            /* enable wall clock timing */
+bench_msec = sim_os_msec ();
+bench_time = sim_gtime ();
 
 do {
     t_addr *addrs;
 
+    sim_profile_start ();                               /* don't charge stop time */
     while (1) {
         r = sim_instr();
         if (r != SCPE_REMOTE)
@@ -8623,6 +9175,7 @@ do {
         sim_sched_step ();
     } while (1);
 
+sim_bench_msec += sim_os_msec () - bench_msec;
 if ((SCPE_BARE_STATUS(r) == SCPE_STOP) &&
     sigterm_received)
     r = SCPE_SIGTERM;
@@ -8652,6 +9205,7 @@ sim_cancel_step ();                                     /* cancel step timer */
 sim_throt_cancel ();                                    /* cancel throttle */
 AIO_UPDATE_QUEUE;
 UPDATE_SIM_TIME;                                        /* update sim time */
+sim_bench_time += sim_gtime () - bench_time;
 return r | ((sim_switches & SWMASK ('Q')) ? SCPE_NOMESSAGE : 0);
 }
 
@@ -11307,6 +11861,115 @@ for (c=0, p=buf; c < len; c++) {
 return buf;
 }
 
+/* Event queue heap primitives
+
+   _sim_queue_before    ordering predicate: earlier due time first, then
+                        earlier insertion
+   _sim_queue_sift_up   move an entry towards the root
+   _sim_queue_sift_down move an entry towards the leaves
+   _sim_queue_set_head  publish the earliest entry as sim_clock_queue
+   _sim_queue_insert    add an entry due event_time from now
+   _sim_queue_remove    remove an arbitrary entry
+
+   The caller is responsible for UPDATE_SIM_TIME before changing the
+   queue and for reloading sim_interval afterwards.
+*/
+
+static t_bool _sim_queue_before (UNIT *a, UNIT *b)
+{
+if (a->q_due != b->q_due)
+    return (a->q_due < b->q_due);
+return (a->q_seq < b->q_seq);
+}
+
+static void _sim_queue_sift_up (uint32 slot)
+{
+UNIT *uptr = sim_clock_heap[slot];
+
+while (slot > 1) {
+    UNIT *pptr = sim_clock_heap[slot >> 1];
+
+    if (!_sim_queue_before (uptr, pptr))
+        break;
+    sim_clock_heap[slot] = pptr;
+    pptr->q_slot = slot;
+    slot = slot >> 1;
+    }
+sim_clock_heap[slot] = uptr;
+uptr->q_slot = slot;
+}
+
+static void _sim_queue_sift_down (uint32 slot)
+{
+UNIT *uptr = sim_clock_heap[slot];
+
+while ((slot << 1) <= sim_clock_heap_cnt) {
+    uint32 child = slot << 1;
+    UNIT *cptr;
+
+    if ((child < sim_clock_heap_cnt) &&
+        _sim_queue_before (sim_clock_heap[child + 1], sim_clock_heap[child]))
+        ++child;
+    cptr = sim_clock_heap[child];
+    if (!_sim_queue_before (cptr, uptr))
+        break;
+    sim_clock_heap[slot] = cptr;
+    cptr->q_slot = slot;
+    slot = child;
+    }
+sim_clock_heap[slot] = uptr;
+uptr->q_slot = slot;
+}
+
+static void _sim_queue_set_head (void)
+{
+if (sim_clock_heap_cnt == 0) {
+    sim_clock_queue = QUEUE_LIST_END;
+    return;
+    }
+sim_clock_queue = sim_clock_heap[1];
+sim_clock_queue->time = (int32)(sim_clock_queue->q_due - sim_clock_qtime);
+}
+
+static t_stat _sim_queue_insert (UNIT *uptr, int32 event_time)
+{
+if (sim_clock_heap_cnt + 1 >= sim_clock_heap_size) {
+    uint32 size = (sim_clock_heap_size == 0) ? 64 : 2 * sim_clock_heap_size;
+    UNIT **heap = (UNIT **)realloc (sim_clock_heap, size * sizeof (*heap));
+
+    if (heap == NULL)
+        return SCPE_MEM;
+    sim_clock_heap = heap;
+    sim_clock_heap_size = size;
+    }
+uptr->q_due = sim_clock_qtime + event_time;
+uptr->q_seq = sim_clock_qseq++;
+uptr->time = event_time;
+uptr->next = QUEUE_LIST_END;                            /* mark as queued */
+sim_clock_heap[++sim_clock_heap_cnt] = uptr;
+_sim_queue_sift_up (sim_clock_heap_cnt);
+_sim_queue_set_head ();
+return SCPE_OK;
+}
+
+static void _sim_queue_remove (UNIT *uptr)
+{
+uint32 slot = uptr->q_slot;
+UNIT *lptr = sim_clock_heap[sim_clock_heap_cnt--];
+
+uptr->q_slot = 0;
+uptr->next = NULL;                                      /* hygiene */
+if (lptr != uptr) {                                     /* fill hole with last entry */
+    sim_clock_heap[slot] = lptr;
+    lptr->q_slot = slot;
+    if ((slot > 1) && _sim_queue_before (lptr, sim_clock_heap[slot >> 1]))
+        _sim_queue_sift_up (slot);
+    else
+        _sim_queue_sift_down (slot);
+    }
+_sim_queue_set_head ();
+}
+
 /* Event queue package
 
         sim_activate            add entry to event queue
@@ -11330,8 +11993,15 @@ return buf;
    and to see if further events need to be processed, or sim_interval
    reset to count the next one.
 
-   The event queue is maintained in clock order; entry timeouts are
-   RELATIVE to the time in the previous entry.
+   The event queue is a binary heap ordered by absolute due time, with
+   entries due at the same time kept in the order they were queued.
+   Each queued unit records its due time (q_due), insertion sequence
+   (q_seq) and heap slot (q_slot), so insertion and removal are both
+   O(log n) in the number of pending events.  The earliest entry is
+   always available as sim_clock_queue and its time field holds its
+   timeout RELATIVE to the current time, which is what sim_interval
+   counts down.  While a unit is on the queue its next field is set to
+   QUEUE_LIST_END so that sim_is_active remains a simple test.
 
    sim_process_event - process event
 
@@ -11362,12 +12032,13 @@ if (sim_clock_queue == QUEUE_LIST_END) {                /* queue empty? */
 sim_processing_event = TRUE;
 do {
     uptr = sim_clock_queue;                             /* get first */
-    sim_clock_queue = uptr->next;                       /* remove first */
-    uptr->next = NULL;                                  /* hygiene */
     sim_interval -= uptr->time;
+    sim_clock_qtime = uptr->q_due - sim_interval;       /* queue time is now its due time */
+    _sim_queue_remove (uptr);                           /* remove first */
     uptr->time = 0;
+    sim_bench_events++;
     if (sim_clock_queue != QUEUE_LIST_END)
-        sim_interval += sim_clock_queue->time;
+        sim_interval = sim_clock_queue->time;
     else
         sim_interval = noqueue_time = NOQUEUE_WAIT;
     AIO_EVENT_BEGIN(uptr);
@@ -11432,8 +12103,7 @@ return _sim_activate (uptr, event_time);
 
 t_stat _sim_activate (UNIT *uptr, int32 event_time)
 {
-UNIT *cptr, *prvptr;
-int32 accum;
+t_stat r;
 
 AIO_ACTIVATE (_sim_activate, uptr, event_time);
 if (sim_is_active (uptr))                               /* already active? */
@@ -11442,27 +12112,10 @@ UPDATE_SIM_TIME;                                        /* update sim time */
 
 sim_debug (SIM_DBG_ACTIVATE, &sim_scp_dev, "Activating %s delay=%d\n", sim_uname (uptr), event_time);
 
-prvptr = NULL;
-accum = 0;
-for (cptr = sim_clock_queue; cptr != QUEUE_LIST_END; cptr = cptr->next) {
-    if (event_time < (accum + cptr->time))
-        break;
-    accum = accum + cptr->time;
-    prvptr = cptr;
-    }
-if (prvptr == NULL) {                                   /* insert at head */
-    cptr = uptr->next = sim_clock_queue;
-    sim_clock_queue = uptr;
-    }
-else {
-    cptr = uptr->next = prvptr->next;                   /* insert at prvptr */
-    prvptr->next = uptr;
-    }
-uptr->time = event_time - accum;
-if (cptr != QUEUE_LIST_END)
-    cptr->time = cptr->time - uptr->time;
-sim_interval = sim_clock_queue->time;
-return SCPE_OK;
+r = _sim_queue_insert (uptr, event_time);
+if (sim_clock_queue != QUEUE_LIST_END)
+    sim_interval = sim_clock_queue->time;
+return r;
 }
 
 /* sim_activate_abs - activate (queue) event even if event already scheduled
@@ -11560,8 +12213,6 @@ return sim_timer_activate_after (uptr, usec_delay);
 
 t_stat sim_cancel (UNIT *uptr)
 {
-UNIT *cptr, *nptr;
-
 AIO_VALIDATE(uptr);
 if ((uptr->cancel) && uptr->cancel (uptr))
     return SCPE_OK;
@@ -11575,23 +12226,8 @@ if (!sim_is_active (uptr))
     return SCPE_OK;
 UPDATE_SIM_TIME;                                        /* update sim time */
 sim_debug (SIM_DBG_EVENT, &sim_scp_dev, "Canceling Event for %s\n", sim_uname(uptr));
-nptr = QUEUE_LIST_END;
-
-if (sim_clock_queue == uptr) {
-    nptr = sim_clock_queue = uptr->next;
-    uptr->next = NULL;                                  /* hygiene */
-    }
-else {
-    for (cptr = sim_clock_queue; cptr != QUEUE_LIST_END; cptr = cptr->next) {
-        if (cptr->next == uptr) {
-            nptr = cptr->next = uptr->next;
-            uptr->next = NULL;                          /* hygiene */
-            break;                                      /* end queue scan */
-            }
-        }
-    }
-if (nptr != QUEUE_LIST_END)
-    nptr->time += (uptr->next) ? 0 : uptr->time;
+if (uptr->q_slot != 0)
+    _sim_queue_remove (uptr);
 if (!uptr->next)
     uptr->time = 0;
 uptr->usecs_remaining = 0;
@@ -11633,21 +12269,14 @@ return (((uptr->next) || AIO_IS_ACTIVE(uptr) || ((uptr->dynflags & UNIT_TMR_UNIT
 
 int32 _sim_activate_queue_time (UNIT *uptr)
 {
-UNIT *cptr;
 int32 accum;
 
-accum = 0;
-for (cptr = sim_clock_queue; cptr != QUEUE_LIST_END; cptr = cptr->next) {
-    if (cptr == sim_clock_queue) {
-        if (sim_interval > 0)
-            accum = accum + sim_interval;
-        }
-    else
-        accum = accum + cptr->time;
-    if (cptr == uptr)
-        return accum + 1;
-    }
-return 0;
+if (uptr->q_slot == 0)                                  /* not on the event queue? */
+    return 0;
+accum = (sim_interval > 0) ? sim_interval : 0;
+if (uptr != sim_clock_queue)
+    accum = accum + (int32)(uptr->q_due - sim_clock_queue->q_due);
+return accum + 1;
 }
 
 int32 _sim_activate_time (UNIT *uptr)
@@ -11672,7 +12301,6 @@ return _sim_activate_time (uptr);
 
 double sim_activate_time_usecs (UNIT *uptr)
 {
-UNIT *cptr;
 int32 accum;
 double result;
 
@@ -11680,17 +12308,9 @@ AIO_VALIDATE(uptr);
 result = sim_timer_activate_time_usecs (uptr);
 if (result >= 0)
     return result;
-accum = 0;
-for (cptr = sim_clock_queue; cptr != QUEUE_LIST_END; cptr = cptr->next) {
-    if (cptr == sim_clock_queue) {
-        if (sim_interval > 0)
-            accum = accum + sim_interval;
-        }
-    else
-        accum = accum + cptr->time;
-    if (cptr == uptr)
-        return 1.0 + uptr->usecs_remaining + ((1000000.0 * accum) / sim_timer_inst_per_sec ());
-    }
+accum = _sim_activate_queue_time (uptr);
+if (accum)
+    return uptr->usecs_remaining + ((1000000.0 * (accum - 1)) / sim_timer_inst_per_sec ()) + 1.0;
 return 0.0;
 }
 
@@ -11725,13 +12345,165 @@ return sim_rtime;
 
 int32 sim_qcount (void)
 {
-int32 cnt;
-UNIT *uptr;
+return (int32)sim_clock_heap_cnt;
+}
+
+/* Instruction profile package.
+
+   When enabled with SET CPU PROFILE the simulator's sim_instr calls
+   sim_profile (op, pc) once per instruction.  Each call counts the
+   instruction against its opcode and against a PC bucket, and charges
+   the simulated time that passed since the previous call to the
+   previous opcode.  When disabled the hook is a single test of
+   sim_profile_on.
+
+   Opcodes are counted modulo PROF_OPS.  The PC buckets divide the
+   default device's address space into at most PROF_BUCKETS pieces.
+
+   The package contains the following public routines:
+
+        sim_set_profile         SET CPU PROFILE, NOPROFILE, PROFILE=RESET
+        sim_show_profile        SHOW CPU PROFILE
+        _sim_profile            count an instruction
+*/
+
+#define PROF_OPS        4096
+#define PROF_BUCKETS    4096
+#define PROF_SHOW       20                              /* rows per table */
+
+static t_uint64 *sim_prof_cnt = NULL;                   /* executions by opcode */
+static t_uint64 *sim_prof_cyc = NULL;                   /* cycles by opcode */
+static t_uint64 *sim_prof_pc = NULL;                    /* executions by PC bucket */
+static uint32 sim_prof_shift = 0;                       /* PC to bucket shift */
+static int32 sim_prof_prev = -1;                        /* previous opcode */
+static double sim_prof_time = 0.0;                      /* time of previous opcode */
+
+static void sim_profile_start (void)
+{
+sim_prof_prev = -1;
+}
+
+static void sim_profile_reset (void)
+{
+if (sim_prof_cnt == NULL)
+    return;
+memset (sim_prof_cnt, 0, PROF_OPS * sizeof (*sim_prof_cnt));
+memset (sim_prof_cyc, 0, PROF_OPS * sizeof (*sim_prof_cyc));
+memset (sim_prof_pc, 0, PROF_BUCKETS * sizeof (*sim_prof_pc));
+sim_prof_prev = -1;
+}
+
+void _sim_profile (uint32 op, t_addr pc)
+{
+double now = sim_gtime ();
+uint32 b = (uint32)(pc >> sim_prof_shift);
+
+op &= PROF_OPS - 1;
+if (sim_prof_prev >= 0)
+    sim_prof_cyc[sim_prof_prev] += (t_uint64)(now - sim_prof_time);
+sim_prof_cnt[op]++;
+sim_prof_pc[(b < PROF_BUCKETS) ? b : PROF_BUCKETS - 1]++;
+sim_prof_prev = (int32)op;
+sim_prof_time = now;
+}
+
+t_stat sim_set_profile (UNIT *uptr, int32 val, CONST char *cptr, void *desc)
+{
+DEVICE *dptr = sim_dflt_dev;
+
+if (val == 0) {                                         /* NOPROFILE? */
+    if (cptr != NULL)
+        return SCPE_ARG;
+    sim_profile_on = FALSE;
+    return SCPE_OK;
+    }
+if ((cptr != NULL) && (*cptr != 0)) {
+    if (MATCH_CMD (cptr, "RESET") != 0)
+        return sim_messagef (SCPE_ARG, "Unknown PROFILE option: %s\n", cptr);
+    sim_profile_reset ();
+    return SCPE_OK;
+    }
+if (sim_prof_cnt == NULL) {
+    sim_prof_cnt = (t_uint64 *)calloc (PROF_OPS, sizeof (*sim_prof_cnt));
+    sim_prof_cyc = (t_uint64 *)calloc (PROF_OPS, sizeof (*sim_prof_cyc));
+    sim_prof_pc = (t_uint64 *)calloc (PROF_BUCKETS, sizeof (*sim_prof_pc));
+    if ((sim_prof_cnt == NULL) || (sim_prof_cyc == NULL) || (sim_prof_pc == NULL)) {
+        free (sim_prof_cnt);
+        free (sim_prof_cyc);
+        free (sim_prof_pc);
+        sim_prof_cnt = sim_prof_cyc = sim_prof_pc = NULL;
+        return SCPE_MEM;
+        }
+    }
+sim_prof_shift = 0;
+while ((dptr != NULL) && (dptr->awidth > sim_prof_shift + 12))
+    sim_prof_shift++;
+sim_prof_prev = -1;
+sim_profile_on = TRUE;
+return SCPE_OK;
+}
+
+/* Index of the largest entry of tab[] not already in top[] */
 
-cnt = 0;
-for (uptr = sim_clock_queue; uptr != QUEUE_LIST_END; uptr = uptr->next)
-    cnt++;
-return cnt;
+static int32 sim_profile_max (t_uint64 *tab, int32 n, int32 *top, int32 ntop)
+{
+int32 i, j, best = -1;
+
+for (i = 0; i < n; i++) {
+    if (tab[i] == 0)
+        continue;
+    for (j = 0; (j < ntop) && (top[j] != i); j++);
+    if ((j == ntop) && ((best < 0) || (tab[i] > tab[best])))
+        best = i;
+    }
+return best;
+}
+
+t_stat sim_show_profile (FILE *st, UNIT *uptr, int32 val, CONST void *desc)
+{
+DEVICE *dptr = sim_dflt_dev;
+uint32 drdx = dptr->dradix ? dptr->dradix : 8;
+uint32 ardx = dptr->aradix ? dptr->aradix : 8;
+t_uint64 total = 0, cycles = 0;
+int32 top[PROF_SHOW];
+int32 i, n;
+char op[64], lo[64], hi[64];
+
+if (sim_prof_cnt == NULL) {
+    fprintf (st, "Profiling %s\n", sim_profile_on ? "enabled" : "disabled");
+    return SCPE_OK;
+    }
+for (i = 0; i < PROF_OPS; i++) {
+    total += sim_prof_cnt[i];
+    cycles += sim_prof_cyc[i];
+    }
+fprintf (st, "Profiling %s, %s instructions, ",
+         sim_profile_on ? "enabled" : "disabled", sim_fmt_numeric ((double)total));
+fprintf (st, "%s cycles\n", sim_fmt_numeric ((double)cycles));
+if (total == 0)
+    return SCPE_OK;
+fprintf (st, "\n%-10s %15s %7s %15s %8s\n", "Opcode", "Count", "%", "Cycles", "Cyc/Ins");
+for (n = 0; n < PROF_SHOW; n++) {
+    if ((i = sim_profile_max (sim_prof_cnt, PROF_OPS, top, n)) < 0)
+        break;
+    top[n] = i;
+    sprint_val (op, (t_value)i, drdx, sizeof (op) - 1, PV_LEFT);
+    fprintf (st, "%-10s %15" LL_FMT "u %6.2f%% %15" LL_FMT "u %8.2f\n", op,
+             sim_prof_cnt[i], (100.0 * sim_prof_cnt[i]) / total,
+             sim_prof_cyc[i], (double)sim_prof_cyc[i] / sim_prof_cnt[i]);
+    }
+fprintf (st, "\n%-21s %15s %7s\n", "PC range", "Count", "%");
+for (n = 0; n < PROF_SHOW; n++) {
+    if ((i = sim_profile_max (sim_prof_pc, PROF_BUCKETS, top, n)) < 0)
+        break;
+    top[n] = i;
+    sprint_val (lo, (t_value)i << sim_prof_shift, ardx, sizeof (lo) - 1, PV_LEFT);
+    sprint_val (hi, (((t_value)i + 1) << sim_prof_shift) - 1, ardx, sizeof (hi) - 1, PV_LEFT);
+    sprintf (op, "%s-%s", lo, hi);
+    fprintf (st, "%-21s %15" LL_FMT "u %6.2f%%\n", op, sim_prof_pc[i],
+             (100.0 * sim_prof_pc[i]) / total);
+    }
+return SCPE_OK;
 }
 
 /* Breakpoint package.  This module replaces the VM-implemented one
@@ -11753,6 +12525,11 @@ return cnt;
    is the bitwise OR of all the type fields).  A simulator need only check for
    a breakpoint of type X if bit SWMASK('X') is set in sim_brk_summ.
 
+   sim_brk_map has a bit set for every address (folded into SIM_BRK_MAP_BITS)
+   which has a breakpoint of any type.  sim_brk_test returns at once when the
+   bit for the address is clear, and a simulator may use sim_brk_mapped to do
+   the same test inline before calling it.
+
    The package contains the following public routines:
 
         sim_brk_init            initialize
@@ -11790,6 +12567,7 @@ sim_brk_tab = (BRKTAB **) realloc (sim_brk_tab, sim_brk_lnt*sizeof (BRKTAB*));
 if (sim_brk_tab == NULL)
     return SCPE_MEM;
 memset (sim_brk_tab, 0, sim_brk_lnt*sizeof (BRKTAB*));
+memset (sim_brk_map, 0, sizeof (sim_brk_map));
 sim_brk_ent = sim_brk_ins = 0;
 sim_brk_clract ();
 sim_brk_npc (0);
@@ -11877,6 +12655,7 @@ if (bp->next == NULL)
 bp->addr = loc;
 bp->typ = btyp;
 bp->cnt = 0;
+sim_brk_map[SIM_BRK_MAP_IDX(loc) >> 5] |= 1u << (SIM_BRK_MAP_IDX(loc) & 0x1F);
 bp->act = NULL;
 for (i = 0; i < SIM_BKPT_N_SPC; i++)
     bp->time_fired[i] = -1.0;
@@ -11960,8 +12739,10 @@ if (sim_brk_tab[sim_brk_ins] == NULL) {                 /* erased entry */
         sim_brk_tab[i] = sim_brk_tab[i+1];
     }
 sim_brk_summ = 0;                                       /* recalc summary */
+memset (sim_brk_map, 0, sizeof (sim_brk_map));          /* and map */
 for (i = 0; i < sim_brk_ent; i++) {
     bp = sim_brk_tab[i];
+    sim_brk_map[SIM_BRK_MAP_IDX(bp->addr) >> 5] |= 1u << (SIM_BRK_MAP_IDX(bp->addr) & 0x1F);
     while (bp) {
         sim_brk_summ |= (bp->typ & ~BRK_TYP_TEMP);
         bp = bp->next;
@@ -12106,6 +12887,8 @@ uint32 sim_brk_test (t_addr loc, uint32 btyp)
 BRKTAB *bp;
 uint32 spc = (btyp >> SIM_BKPT_V_SPC) & (SIM_BKPT_N_SPC - 1);
 
+if (!sim_brk_mapped (loc))                              /* nothing here? */
+    return 0;
 if (sim_brk_summ & BRK_TYP_DYN_ALL)
     btyp |= BRK_TYP_DYN_ALL;
 
@@ -15502,6 +16285,74 @@ return stat;
 }
 
 
+/*
+ * Event queue exercise: schedule increasing numbers of events with
+ * pseudo random delays, verify the heap ordering and reported activation
+ * times, and report the average cost of sim_activate and sim_cancel so
+ * that the growth per operation can be seen to be logarithmic.
+ */
+
+static t_stat sim_queue_test (void)
+{
+static const uint32 sizes[] = {1000, 10000, 100000};
+uint32 s, i, n;
+UNIT *units;
+int32 *delays;
+t_stat stat = SCPE_OK;
+
+sim_printf ("Event Queue Tests:\n");
+for (s = 0; (s < sizeof (sizes) / sizeof (sizes[0])) && (stat == SCPE_OK); s++) {
+    uint32 seed = 12345;
+    double start, act_time, can_time;
+
+    n = sizes[s];
+    units = (UNIT *)calloc (n, sizeof (*units));
+    delays = (int32 *)calloc (n, sizeof (*delays));
+    if ((units == NULL) || (delays == NULL)) {
+        free (units);
+        free (delays);
+        return SCPE_MEM;
+        }
+    for (i = 0; i < n; i++) {
+        seed = seed * 1103515245 + 12345;
+        delays[i] = (int32)((seed >> 8) % 10000000);
+        units[i].uname = (char *)"EVQTEST";
+        }
+    start = sim_timenow_double ();
+    for (i = 0; i < n; i++)
+        _sim_activate (&units[i], delays[i]);
+    act_time = sim_timenow_double () - start;
+    for (i = 2; i <= sim_clock_heap_cnt; i++)
+        if (_sim_queue_before (sim_clock_heap[i], sim_clock_heap[i >> 1])) {
+            sim_printf ("  Heap order violated at slot %u\n", i);
+            stat = SCPE_IERR;
+            break;
+            }
+    for (i = 0; (i < n) && (stat == SCPE_OK); i++) {
+        if (_sim_activate_queue_time (&units[i]) != delays[i] + 1) {
+            sim_printf ("  Event %u due at %d, queue reports %d\n", i, delays[i], _sim_activate_queue_time (&units[i]) - 1);
+            stat = SCPE_IERR;
+            }
+        }
+    start = sim_timenow_double ();
+    for (i = 0; i < n; i++)
+        sim_cancel (&units[(i * 7919) % n]);
+    can_time = sim_timenow_double () - start;
+    for (i = 0; i < n; i++)
+        if (sim_is_active (&units[i])) {
+            sim_cancel (&units[i]);
+            if (stat == SCPE_OK)
+                sim_printf ("  Event %u still queued after cancel\n", i);
+            stat = SCPE_IERR;
+            }
+    sim_printf ("  %7u events: activate %.3f usecs/event, cancel %.3f usecs/event\n", n, 
+                (1000000.0 * act_time) / n, (1000000.0 * can_time) / n);
+    free (units);
+    free (delays);
+    }
+return stat;
+}
+
 /*
  * Compiled in unit tests for the various device oriented library 
  * modules: sim_card, sim_disk, sim_tape, sim_ether, sim_tmxr, etc.
@@ -15523,6 +16374,8 @@ cptr = get_glyph (cptr, gbuf, 0);
 if (gbuf[0] == '\0')
     strcpy (gbuf, "ALL");
 else {
+    if (strcmp (gbuf, "QUEUE") == 0)
+        return sim_queue_test ();
     if (!find_dev (gbuf))
         return sim_messagef (SCPE_ARG, "No such device: %s\n", gbuf);
     }
@@ -15531,6 +16384,9 @@ if (sim_switches & SWMASK ('D')) {
     sim_set_debon (0, "STDOUT");
     sim_switches = saved_switches;
     }
+if ((strcmp (gbuf, "ALL") == 0) && 
+    ((stat = sim_queue_test ()) != SCPE_OK))
+    return stat;
 for (i = 0; (dptr = sim_devices[i]) != NULL; i++) {
     t_stat tstat = SCPE_OK;
     t_bool was_disabled = ((dptr->flags & DEV_DIS) != 0);
@@ -293,6 +293,13 @@ t_stat get_aval (t_addr addr, DEVICE *dptr, UNIT *uptr);
 t_value get_rval (REG *rptr, uint32 idx);
 BRKTAB *sim_brk_fnd (t_addr loc);
 uint32 sim_brk_test (t_addr bloc, uint32 btyp);
+#define SIM_BRK_MAP_BITS 65536                          /* breakpoint presence map size */
+#define SIM_BRK_MAP_IDX(loc) ((uint32)((loc) ^ ((loc) >> 16)) & (SIM_BRK_MAP_BITS - 1))
+#define sim_brk_mapped(loc) ((sim_brk_map[SIM_BRK_MAP_IDX(loc) >> 5] >> (SIM_BRK_MAP_IDX(loc) & 0x1F)) & 1)
+t_stat sim_set_profile (UNIT *uptr, int32 val, CONST char *cptr, void *desc);
+t_stat sim_show_profile (FILE *st, UNIT *uptr, int32 val, CONST void *desc);
+void _sim_profile (uint32 op, t_addr pc);
+#define sim_profile(op, pc) do { if (sim_profile_on) _sim_profile (op, pc); } while (0)
 void sim_brk_clrspc (uint32 spc, uint32 btyp);
 void sim_brk_npc (uint32 cnt);
 void sim_brk_setact (const char *action);
@@ -391,6 +398,7 @@ extern DEVICE **sim_internal_devices;
 extern uint32 sim_internal_device_count;
 extern UNIT *sim_clock_queue;
 extern volatile t_bool sim_is_running;
+extern t_bool sim_profile_on;                           /* instruction profile enabled */
 extern t_bool sim_processing_event;                     /* Called from sim_process_event */
 extern char *sim_prompt;                                /* prompt string */
 extern const char *sim_savename;                        /* Simulator Name used in Save/Restore files */
@@ -399,6 +407,7 @@ extern volatile t_bool stop_cpu;
 extern uint32 sim_brk_types;                            /* breakpoint info */
 extern uint32 sim_brk_dflt;
 extern uint32 sim_brk_summ;
+extern uint32 sim_brk_map[SIM_BRK_MAP_BITS / 32];
 extern uint32 sim_brk_match_type;
 extern t_addr sim_brk_match_addr;
 extern BRKTYPTAB *sim_brk_type_desc;                    /* type descriptions */
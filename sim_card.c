@@ -58,6 +58,12 @@
     Auto output format is ASCII if card has only printable characters
     or card format binary.
 
+    Decks attached with -B are streamed: cards are parsed from the file
+    as they are needed, by a read ahead thread when asynchronous I/O is
+    available, and only the last DECK_WINDOW cards are kept in memory.
+    Until the last deck has been read the input hopper count only
+    includes the cards read ahead.
+
     The card module uses up7 to hold a buffer for the card being translated
     and the backward translation table. Which is generated from the table.
 */
@@ -66,6 +72,9 @@
 #include <ctype.h>
 #include "sim_defs.h"
 #include "sim_card.h"
+#if defined(SIM_ASYNCH_IO)
+#include <pthread.h>
+#endif
 
 #if defined(USE_SIM_CARD)
 
@@ -74,7 +83,42 @@
 #define CARD_EOF          0x1000         /* This card is end of file card. */
 #define CARD_ERR          0x2000         /* Return error for this card */
 #define DECK_SIZE         1000           /* Number of cards to allocate at a time */
+#define DECK_WINDOW       4096           /* Cards kept in memory when streaming */
+
+/* Card n of the hopper, the hopper is a ring of DECK_WINDOW cards when streaming */
+#define CARD_IMAGE(d, n)  (&(*(d)->images)[(n) % (d)->hopper_size])
+
+struct _card_buffer {
+   uint8                 buffer[8192+500];    /* Buffer data */
+   int                   len;                 /* Amount of data in buffer */
+   int                   size;                /* Size of last card read */
+};
 
+struct card_deck                         /* Deck waiting to be streamed */
+{
+    struct card_deck    *next;           /* Next deck in hopper */
+    FILE                *fileref;        /* Deck file */
+    uint32              flags;           /* Unit flags at attach, for format */
+    int                 eof;             /* Add EOF card after deck */
+    t_addr              cards;           /* Cards read from this deck */
+    t_stat              error;           /* Parse error, rest of deck skipped */
+    char                *name;           /* Deck file name, for messages */
+};
+
+struct card_stream
+{
+    struct card_deck    *decks;          /* All decks streamed */
+    struct card_deck    *cur;            /* Deck being read, NULL when all read */
+    struct _card_buffer buf;             /* Read buffer for current deck */
+    struct card_deck    *bad;            /* Deck with an unreported error */
+#if defined(SIM_ASYNCH_IO)
+    int                 asynch;          /* Read ahead thread running */
+    int                 stop;            /* Tell read ahead thread to exit */
+    pthread_t           thread;          /* Read ahead thread */
+    pthread_mutex_t     lock;            /* Protects hopper and deck list */
+    pthread_cond_t      cond;            /* Signaled when hopper changes */
+#endif
+};
 
 struct card_context
 {
@@ -84,8 +128,22 @@ struct card_context
     t_addr              hopper_size;     /* Size of hopper */
     t_addr              hopper_cards;    /* Number of cards in hopper */
     uint16              (*images)[1][80];
+    struct card_stream  *stream;         /* Streaming decks, NULL if none */
 };
 
+#if defined(SIM_ASYNCH_IO)
+#define STREAM_LOCK(d)    if ((d)->stream) pthread_mutex_lock (&(d)->stream->lock)
+#define STREAM_UNLOCK(d)  if ((d)->stream) {                          \
+                              pthread_cond_broadcast (&(d)->stream->cond); \
+                              pthread_mutex_unlock (&(d)->stream->lock);   \
+                          }
+#else
+#define STREAM_LOCK(d)
+#define STREAM_UNLOCK(d)
+#endif
+
+static int _sim_card_ready(UNIT *uptr, struct card_context *data);
+
 /* Character conversion tables */
 
 const char          sim_six_to_ascii[64] = {
@@ -499,16 +557,26 @@ t_addr
 sim_card_input_hopper_count(UNIT *uptr) {
     struct card_context  *data = (struct card_context *)uptr->card_ctx;
     uint16                col;
+    t_addr                count;
 
     if (data == NULL || data->images == NULL)
         return 0;           /* attached? */
 
-    if (uptr->pos >= data->hopper_cards)
+    STREAM_LOCK(data);
+    if (!_sim_card_ready(uptr, data)) {
+        STREAM_UNLOCK(data);
         return 0;
+    }
 
-    col = (*data->images)[data->hopper_cards-1][0];
-
-    return (int)((data->hopper_cards - uptr->pos) - ((col & CARD_EOF) ? 1 : 0));
+    /* A streaming hopper only counts the cards read ahead so far, and
+       its last card is only the final EOF card once all decks are read */
+    col = (*CARD_IMAGE(data, data->hopper_cards-1))[0];
+    count = data->hopper_cards - uptr->pos;
+    if ((col & CARD_EOF) &&
+        (data->stream == NULL || data->stream->cur == NULL))
+        count--;
+    STREAM_UNLOCK(data);
+    return (int)count;
 }
 
 t_addr
@@ -533,11 +601,14 @@ sim_read_card(UNIT * uptr, uint16 image[80])
 
     if (data == NULL || (uptr->flags & UNIT_ATT) == 0)
         return CDSE_EMPTY;      /* attached? */
-    if (data->hopper_cards == 0 || uptr->pos >= data->hopper_cards)
+    STREAM_LOCK(data);
+    if (!_sim_card_ready(uptr, data)) {
+        STREAM_UNLOCK(data);
         return CDSE_EMPTY;
+    }
 
     dptr = find_dev_from_unit( uptr);
-    img = &(*data->images)[uptr->pos];
+    img = CARD_IMAGE(data, uptr->pos);
     if (sim_deb && dptr && ((dptr)->dctrl & DEBUG_CARD)) {
          if (image[0] & CARD_EOF) {
              sim_debug(DEBUG_CARD, dptr, "Read hopper EOF\n");
@@ -570,6 +641,7 @@ sim_read_card(UNIT * uptr, uint16 image[80])
     uptr->pos++;
     data->punch_count++;
     memcpy(image, img, 80 * sizeof(uint16));
+    STREAM_UNLOCK(data);
     image[0] &= 0xfff;          /* Remove any CARD_EOF and CARD_ERR Flags */
     return r;
 }
@@ -586,10 +658,14 @@ sim_card_eof(UNIT *uptr)
     if (data == NULL || data->images == NULL)
         return SCPE_UNATT;      /* attached? */
 
-    if (uptr->pos >= data->hopper_cards)
+    STREAM_LOCK(data);
+    if (!_sim_card_ready(uptr, data)) {
+        STREAM_UNLOCK(data);
         return SCPE_UNATT;
+    }
 
-    col = (*data->images)[uptr->pos][0];
+    col = (*CARD_IMAGE(data, uptr->pos))[0];
+    STREAM_UNLOCK(data);
 
     if (col & CARD_EOF)
         return 1;
@@ -598,12 +674,6 @@ sim_card_eof(UNIT *uptr)
 
 
 
-struct _card_buffer {
-   uint8                 buffer[8192+500];    /* Buffer data */
-   int                   len;                 /* Amount of data in buffer */
-   int                   size;                /* Size of last card read */
-};
-
 static int _cmpcard(const uint8 *p, const char *s) {
    int  i;
    if (p[0] != '~')
@@ -616,7 +686,7 @@ static int _cmpcard(const uint8 *p, const char *s) {
 }
 
 t_stat
-_sim_parse_card(UNIT *uptr, DEVICE *dptr, struct _card_buffer *buf, uint16 (*image)[80]) {
+_sim_parse_card(uint32 flags, DEVICE *dptr, struct _card_buffer *buf, uint16 (*image)[80]) {
     int                   mode;
     uint16                temp;
     int                   i;
@@ -624,7 +694,7 @@ _sim_parse_card(UNIT *uptr, DEVICE *dptr, struct _card_buffer *buf, uint16 (*ima
     int                   col;
 
     sim_debug(DEBUG_CARD, dptr, "Read card ");
-    if ((uptr->flags & UNIT_CARD_MODE) == MODE_AUTO) {
+    if ((flags & UNIT_CARD_MODE) == MODE_AUTO) {
         mode = MODE_TEXT;   /* Default is text */
 
         /* Check buffer to see if binary card in it. */
@@ -661,22 +731,22 @@ _sim_parse_card(UNIT *uptr, DEVICE *dptr, struct _card_buffer *buf, uint16 (*ima
         }
 
         /* Check if modes match */
-        if ((uptr->flags & UNIT_CARD_MODE) != MODE_AUTO &&
-            (uptr->flags & UNIT_CARD_MODE) != mode) {
+        if ((flags & UNIT_CARD_MODE) != MODE_AUTO &&
+            (flags & UNIT_CARD_MODE) != mode) {
             (*image)[0] = CARD_ERR;
             sim_debug(DEBUG_CARD, dptr, "invalid mode\n");
             return SCPE_OPENERR;
         }
     } else
-        mode = uptr->flags & UNIT_CARD_MODE;
+        mode = flags & UNIT_CARD_MODE;
 
     switch(mode) {
     default:
     case MODE_TEXT:
         sim_debug(DEBUG_CARD, dptr, "%s text: [",
-            (uptr->flags & MODE_CHAR) == MODE_026 ? "026" :
-            (uptr->flags & MODE_CHAR) == MODE_029 ? "029" :
-            (uptr->flags & MODE_CHAR) == MODE_EBCDIC ? "EBCDIC" :
+            (flags & MODE_CHAR) == MODE_026 ? "026" :
+            (flags & MODE_CHAR) == MODE_029 ? "029" :
+            (flags & MODE_CHAR) == MODE_EBCDIC ? "EBCDIC" :
             "unknown");
         /* Check for special codes */
         if (buf->buffer[0] == '~') {
@@ -750,9 +820,9 @@ _sim_parse_card(UNIT *uptr, DEVICE *dptr, struct _card_buffer *buf, uint16 (*ima
                     break;
                 default:
                     sim_debug(DEBUG_CARD, dptr, "%c", c);
-                    if ((uptr->flags & MODE_LOWER) == 0)
+                    if ((flags & MODE_LOWER) == 0)
                         c = toupper(c);
-                    switch(uptr->flags & MODE_CHAR) {
+                    switch(flags & MODE_CHAR) {
                     default:
                     case MODE_026:
                            temp = ascii_to_hol_026[(int)c];
@@ -952,7 +1022,7 @@ _sim_read_deck(UNIT * uptr, int eof)
 
         /* Process one card */
         cards++;
-        if (_sim_parse_card(uptr, dptr, &buf, &(*data->images)[data->hopper_cards])
+        if (_sim_parse_card(uptr->flags, dptr, &buf, &(*data->images)[data->hopper_cards])
                 != SCPE_OK) {
             r = sim_messagef(SCPE_OPENERR, "%s: %s Error (%s) in card %d\n",
                    sim_uname(uptr), uptr->filename, sim_error_text(r), cards);
@@ -989,6 +1059,228 @@ _sim_read_deck(UNIT * uptr, int eof)
 }
 
 
+
+/* Read the next card of a streaming deck into image.
+   Return 0 for a card, 1 for the last card of the deck (EOF or error
+   card) and 2 if the deck ended without a card. */
+static int
+_sim_stream_card(struct card_stream *st, struct card_deck *deck, DEVICE *dptr,
+                 uint16 (*image)[80])
+{
+    struct _card_buffer  *buf = &st->buf;
+    int                   i;
+    int                   j;
+    int                   l;
+
+    if (buf->len < 500 && !feof(deck->fileref)) {
+        l = sim_fread(&buf->buffer[buf->len], 1, 8192, deck->fileref);
+        if (l > 0)
+            buf->len += l;
+    }
+    memset(image, 0, sizeof(*image));
+    if (buf->len == 0 && deck->cards != 0) {
+        if (!deck->eof)
+            return 2;
+        (*image)[0] = CARD_EOF;         /* Create empty card */
+        return 1;
+    }
+
+    /* Process one card */
+    deck->cards++;
+    deck->error = _sim_parse_card(deck->flags, dptr, buf, image);
+    if (deck->error != SCPE_OK)
+        return 1;                       /* Reported by _sim_card_ready */
+    /* Move data to start at begining of buffer */
+    l = buf->len - buf->size;
+    j = buf->size;
+    for(i = 0; i < l; i++, j++)
+        buf->buffer[i] = buf->buffer[j];
+    buf->len -= buf->size;
+    return 0;
+}
+
+/* Add a card read from a streaming deck to the hopper, lock held */
+static void
+_sim_stream_put(struct card_context *data, struct card_deck *deck, int r,
+                uint16 (*image)[80])
+{
+    struct card_stream   *st = data->stream;
+
+    if (r != 2) {
+        memcpy(CARD_IMAGE(data, data->hopper_cards), image, sizeof(*image));
+        data->hopper_cards++;
+    }
+    if (r != 0) {                       /* End of deck, go to next one */
+        if (deck->error != SCPE_OK)
+            st->bad = deck;
+        st->cur = deck->next;
+        st->buf.len = 0;
+        st->buf.size = 0;
+    }
+}
+
+#if defined(SIM_ASYNCH_IO)
+/* Read ahead thread, keeps the hopper window full */
+static void *
+_sim_card_reader(void *arg)
+{
+    UNIT                 *uptr = (UNIT *)arg;
+    struct card_context  *data = (struct card_context *)uptr->card_ctx;
+    struct card_stream   *st = data->stream;
+    DEVICE               *dptr = find_dev_from_unit(uptr);
+    struct card_deck     *deck;
+    uint16                image[80];
+    int                   r;
+
+    pthread_mutex_lock (&st->lock);
+    while (!st->stop) {
+        deck = st->cur;
+        if (deck == NULL || data->hopper_cards >= uptr->pos + data->hopper_size) {
+            pthread_cond_wait (&st->cond, &st->lock);
+            continue;
+        }
+        pthread_mutex_unlock (&st->lock);
+        r = _sim_stream_card(st, deck, dptr, &image);
+        pthread_mutex_lock (&st->lock);
+        _sim_stream_put(data, deck, r, &image);
+        pthread_cond_broadcast (&st->cond);
+    }
+    pthread_mutex_unlock (&st->lock);
+    return NULL;
+}
+#endif
+
+/* Check if the card at uptr->pos is in the hopper. A streaming hopper
+   reads ahead until it is, or until all decks have been read, and
+   reports a deck that could not be parsed. Called from the simulator
+   thread with the stream lock held. */
+static int
+_sim_card_ready(UNIT *uptr, struct card_context *data)
+{
+    struct card_stream   *st = data->stream;
+    struct card_deck     *deck;
+    uint16                image[80];
+    int                   r;
+
+    if (st != NULL) {
+        if (uptr->pos + data->hopper_size < data->hopper_cards)
+            return 0;                   /* Card has left the window */
+        while (uptr->pos >= data->hopper_cards && (deck = st->cur) != NULL) {
+#if defined(SIM_ASYNCH_IO)
+            if (st->asynch) {
+                pthread_cond_broadcast (&st->cond);
+                pthread_cond_wait (&st->cond, &st->lock);
+                continue;
+            }
+#endif
+            r = _sim_stream_card(st, deck, find_dev_from_unit(uptr), &image);
+            _sim_stream_put(data, deck, r, &image);
+        }
+        if ((deck = st->bad) != NULL) {
+            st->bad = NULL;
+            sim_messagef(SCPE_OPENERR, "%s: %s Error (%s) in card %d, rest of deck skipped\n",
+                   sim_uname(uptr), deck->name, sim_error_text(deck->error),
+                   (int)deck->cards);
+        }
+    }
+    return uptr->pos < data->hopper_cards;
+}
+
+/* Add the deck attached to uptr to a streaming hopper, creating the
+   stream if needed. The hopper takes over the deck file. */
+static t_stat
+_sim_stream_deck(UNIT *uptr, int eof)
+{
+    struct card_context  *data = (struct card_context *)uptr->card_ctx;
+    struct card_stream   *st = data->stream;
+    struct card_deck     *deck;
+    struct card_deck    **dp;
+
+    if (st == NULL) {
+        uint16            (*images)[1][80];
+        t_addr             size = DECK_WINDOW;
+        t_addr             n;
+
+        /* Cards still to be read move into the window */
+        if (data->hopper_cards > uptr->pos &&
+            data->hopper_cards - uptr->pos >= size)
+            size = data->hopper_cards - uptr->pos + DECK_SIZE;
+        images = (uint16 (*)[1][80])calloc((size_t)size, sizeof(*images));
+        st = (struct card_stream *)calloc(1, sizeof(*st));
+        if (images == NULL || st == NULL) {
+            free(images);
+            free(st);
+            return SCPE_MEM;
+        }
+        for (n = uptr->pos; n < data->hopper_cards; n++)
+            memcpy(&(*images)[n % size], CARD_IMAGE(data, n), sizeof(*images));
+        free(data->images);
+        data->images = images;
+        data->hopper_size = size;
+#if defined(SIM_ASYNCH_IO)
+        pthread_mutex_init (&st->lock, NULL);
+        pthread_cond_init (&st->cond, NULL);
+#endif
+        data->stream = st;
+    }
+
+    deck = (struct card_deck *)calloc(1, sizeof(*deck));
+    if (deck == NULL)
+        return SCPE_MEM;
+    deck->name = strdup(uptr->filename);
+    if (deck->name == NULL) {
+        free(deck);
+        return SCPE_MEM;
+    }
+    deck->fileref = uptr->fileref;
+    uptr->fileref = NULL;
+    deck->flags = uptr->flags;
+    deck->eof = eof;
+    STREAM_LOCK(data);
+    for (dp = &st->decks; *dp != NULL; dp = &(*dp)->next)
+        ;
+    *dp = deck;
+    if (st->cur == NULL)
+        st->cur = deck;
+    STREAM_UNLOCK(data);
+#if defined(SIM_ASYNCH_IO)
+    if (!st->asynch && sim_asynch_enabled &&
+        pthread_create (&st->thread, NULL, _sim_card_reader, uptr) == 0)
+        st->asynch = 1;
+#endif
+    return SCPE_OK;
+}
+
+/* Stop streaming and close all streamed decks */
+static void
+_sim_stream_free(struct card_context *data)
+{
+    struct card_stream   *st = data->stream;
+    struct card_deck     *deck;
+
+    if (st == NULL)
+        return;
+#if defined(SIM_ASYNCH_IO)
+    if (st->asynch) {
+        pthread_mutex_lock (&st->lock);
+        st->stop = 1;
+        pthread_cond_broadcast (&st->cond);
+        pthread_mutex_unlock (&st->lock);
+        pthread_join (st->thread, NULL);
+    }
+    pthread_cond_destroy (&st->cond);
+    pthread_mutex_destroy (&st->lock);
+#endif
+    while ((deck = st->decks) != NULL) {
+        st->decks = deck->next;
+        fclose(deck->fileref);
+        free(deck->name);
+        free(deck);
+    }
+    free(st);
+    data->stream = NULL;
+}
+
 /* Card punch routine
 
    Modifiers have been checked by the caller
@@ -1196,6 +1488,7 @@ sim_card_attach(UNIT * uptr, CONST char *cptr)
     char                *saved_filename;
     t_bool              was_attached = (uptr->flags & UNIT_ATT);
     t_addr              saved_pos;
+    int                 stream;
     static int          ebcdic_init = 0;
 
     if ((uptr->flags & UNIT_RO) &&      /* Attaching a Reader */
@@ -1298,6 +1591,7 @@ sim_card_attach(UNIT * uptr, CONST char *cptr)
         /* Check if we should append to end of existing */
         if ((sim_switches & SWMASK ('S')) == 0) {
            previous_cards = 0;
+           _sim_stream_free(data);
            data->hopper_cards = 0;
            data->hopper_size = 0;
            data->punch_count = 0;
@@ -1308,8 +1602,13 @@ sim_card_attach(UNIT * uptr, CONST char *cptr)
            saved_pos = 0;
         }
 
-        /* Go read the deck */
-        r = _sim_read_deck(uptr, eof);
+        /* Go read the deck, or queue it if streaming */
+        uptr->pos = saved_pos;
+        stream = (sim_switches & SWMASK ('B')) || data->stream != NULL;
+        if (stream)
+            r = _sim_stream_deck(uptr, eof);
+        else
+            r = _sim_read_deck(uptr, eof);
         uptr->pos = saved_pos;
         detach_unit(uptr);
         if (was_attached) {
@@ -1329,15 +1628,20 @@ sim_card_attach(UNIT * uptr, CONST char *cptr)
             uptr->dynflags |= UNIT_ATTMULT;
             if (saved_filename) {
                 uptr->filename = (char *)malloc (32 + strlen (cptr) + strlen (saved_filename));
-                sprintf (uptr->filename, "%s, %s-F %s %s", saved_filename,
-                     (eof)? "-E ": "", fmt, cptr);
+                sprintf (uptr->filename, "%s, %s%s-F %s %s", saved_filename,
+                     (eof)? "-E ": "", (stream)? "-B ": "", fmt, cptr);
                 free(saved_filename);
             } else {
                 uptr->filename = (char *)malloc (32 + strlen (cptr));
-                sprintf (uptr->filename, "%s-F %s %s", (eof)?"-E ": "", fmt, cptr);
+                sprintf (uptr->filename, "%s%s-F %s %s", (eof)?"-E ": "",
+                     (stream)? "-B ": "", fmt, cptr);
             }
-            r = sim_messagef(SCPE_OK, "%s: %d card Deck Loaded from %s\n",
-                       sim_uname(uptr), (int)(data->hopper_cards - previous_cards), cptr);
+            if (stream)
+                r = sim_messagef(SCPE_OK, "%s: Card Deck Streaming from %s\n",
+                           sim_uname(uptr), cptr);
+            else
+                r = sim_messagef(SCPE_OK, "%s: %d card Deck Loaded from %s\n",
+                           sim_uname(uptr), (int)(data->hopper_cards - previous_cards), cptr);
         } else {
             if (uptr->dynflags & UNIT_ATTMULT)
                 uptr->flags |= UNIT_ATT;
@@ -1356,6 +1660,7 @@ sim_card_detach(UNIT * uptr)
     if (uptr->card_ctx != 0) {
         struct card_context * data = (struct card_context *)uptr->card_ctx;
         /* No clear any existing decks on stack */
+        _sim_stream_free(data);
         free(data->images);
         free(uptr->card_ctx);
         uptr->card_ctx = 0;
@@ -1408,6 +1713,9 @@ t_stat sim_card_attach_help(FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, cons
     if (readers != 0) {
         fprintf (st, "    -E          Return EOF after deck read\n");
         fprintf (st, "    -S          Append deck to cards currently waiting to be read\n");
+        fprintf (st, "    -B          Stream a big deck from the file as it is read instead\n");
+        fprintf (st, "                of loading it all at attach time. Decks stacked on a\n");
+        fprintf (st, "                streaming deck are streamed too\n");
     }
     return SCPE_OK;
 }
@@ -1435,6 +1743,8 @@ t_stat stat = SCPE_OK;
 char cmd[CBUFSIZE];
 char saved_filename[4*CBUFSIZE];
 uint16 card_image[80];
+struct card_context *data;
+int cards, i, n;
 SIM_TEST_INIT;
 
 if ((dptr->units->flags & UNIT_RO) == 0)  /* Punch device? */
@@ -1451,6 +1761,7 @@ SIM_TEST(create_card_file ("File10.deck", 10));
 SIM_TEST(create_card_file ("File20.deck", 20));
 SIM_TEST(create_card_file ("File30.deck", 30));
 SIM_TEST(create_card_file ("File40.deck", 40));
+SIM_TEST(create_card_file ("File10000.deck", 10000));
 
 sprintf (cmd, "%s File10.deck", dptr->name);
 SIM_TEST(attach_cmd (0, cmd));
@@ -1479,6 +1790,43 @@ show_cmd (0, dptr->name);
 sim_printf ("Input Hopper Count:  %d\n", (int)sim_card_input_hopper_count(dptr->units));
 sim_printf ("Output Hopper Count: %d\n", (int)sim_card_output_hopper_count(dptr->units));
 SIM_TEST(detach_cmd (0, dptr->name));
+sim_printf ("Streaming decks\n");
+sprintf (cmd, "%s -B File10000.deck", dptr->name);
+SIM_TEST(attach_cmd (0, cmd));
+sprintf (cmd, "%s -S File20.deck", dptr->name);
+SIM_TEST(attach_cmd (0, cmd));
+sprintf (cmd, "%s -S -E File40.deck", dptr->name);
+SIM_TEST(attach_cmd (0, cmd));
+show_cmd (0, dptr->name);
+data = (struct card_context *)dptr->units->card_ctx;
+for (cards = 0; !sim_card_eof (dptr->units); cards++) {
+    SIM_TEST(sim_read_card (dptr->units, card_image));
+    for (i = n = 0; i < 5; i++)             /* Check card sequence number */
+        n = n * 10 + data->hol_to_ascii[card_image[i]] - '0';
+    if (n != ((cards < 10000) ? cards : (cards < 10020) ? cards - 10000 : cards - 10020))
+        SIM_TEST(sim_messagef (SCPE_IERR, "Card %d out of sequence (%d)\n", cards, n));
+}
+if (cards != 10060)
+    SIM_TEST(sim_messagef (SCPE_IERR, "Streamed %d cards, expected 10060\n", cards));
+sim_printf ("Streamed %d cards\n", cards);
+sim_printf ("Input Hopper Count:  %d\n", (int)sim_card_input_hopper_count(dptr->units));
+sim_printf ("Output Hopper Count: %d\n", (int)sim_card_output_hopper_count(dptr->units));
+SIM_TEST(detach_cmd (0, dptr->name));
+sprintf (cmd, "%s -B -E File20.deck", dptr->name);   /* EOF card between decks */
+SIM_TEST(attach_cmd (0, cmd));
+sprintf (cmd, "%s -S File40.deck", dptr->name);
+SIM_TEST(attach_cmd (0, cmd));
+for (cards = 0; !sim_card_eof (dptr->units); cards++)
+    SIM_TEST(sim_read_card (dptr->units, card_image));
+if ((cards != 20) || (sim_card_input_hopper_count(dptr->units) == 0))
+    SIM_TEST(sim_messagef (SCPE_IERR, "Hopper empty at EOF card after %d cards\n", cards));
+(void)sim_read_card (dptr->units, card_image);      /* EOF card */
+for (cards = 0; !sim_card_eof (dptr->units); cards++)
+    SIM_TEST(sim_read_card (dptr->units, card_image));
+if (cards != 40)
+    SIM_TEST(sim_messagef (SCPE_IERR, "Streamed %d cards after EOF card, expected 40\n", cards));
+SIM_TEST(detach_cmd (0, dptr->name));
+(void)remove ("File10000.deck");
 (void)remove ("file10.deck");
 (void)remove ("file20.deck");
 (void)remove ("file30.deck");
@@ -609,6 +609,11 @@ struct UNIT {
     char                *uname;                         /* Unit name */
     DEVICE              *dptr;                          /* DEVICE linkage (backpointer) */
     uint32              dctrl;                          /* debug control */
+    double              q_due;                          /* event queue absolute due time */
+    t_uint64            q_seq;                          /* event queue insertion order */
+    uint32              q_slot;                         /* event queue heap slot (0 if idle) */
+    void                *fmap;                          /* file mapping (sim_fmap) */
+    void                *spool;                         /* printer spool (sim_spool) */
 #ifdef SIM_ASYNCH_IO
     void                (*a_check_completion)(UNIT *);
     t_bool              (*a_is_active)(UNIT *);
@@ -662,6 +667,7 @@ struct UNIT {
 #define UNIT_TM_POLL        0000002         /* TMXR Polling unit */
 #define UNIT_NO_FIO         0000004         /* fileref is NOT a FILE * */
 #define UNIT_DISK_CHK       0000010         /* disk data debug checking (sim_disk) */
+#define UNIT_FMAP           0000020         /* attached file is memory mapped (sim_fmap) */
 #define UNIT_TMR_UNIT       0000200         /* Unit registered as a calibrated timer */
 #define UNIT_TAPE_MRK       0000400         /* Tape Unit Tapemark */
 #define UNIT_TAPE_PNU       0001000         /* Tape Unit Position Not Updated */
@@ -1236,7 +1242,9 @@ extern int32 sim_asynch_inst_latency;
 #endif
 #define AIO_ILOCK AIO_LOCK
 #define AIO_IUNLOCK AIO_UNLOCK
-#define AIO_QUEUE_VAL (UNIT *)(InterlockedCompareExchangePointer((void * volatile *)&sim_asynch_queue, (void *)sim_asynch_queue, NULL))
+/* A plain read of the volatile head is enough, every update is then
+   validated by the compare and swap in AIO_QUEUE_SET */
+#define AIO_QUEUE_VAL sim_asynch_queue
 #define AIO_QUEUE_SET(newval, oldval) (UNIT *)(InterlockedCompareExchangePointer((void * volatile *)&sim_asynch_queue, (void *)newval, oldval))
 #define AIO_UPDATE_QUEUE sim_aio_update_queue ()
 #define AIO_ACTIVATE(caller, uptr, event_time)                                   \
@@ -1302,6 +1310,11 @@ extern int32 sim_asynch_inst_latency;
       return SCPE_OK;                                                  \
     } else (void)0
 #endif /* USE_AIO_INTRINSICS */
+/* Unlocked look at the queue head, so that the instruction loop only
+   pays for one load while nothing is queued.  An event queued just
+   after the look is found at the next check; the producer also forces
+   that check by clearing sim_asynch_check. */
+#define AIO_QUEUE_PENDING (sim_asynch_queue != QUEUE_LIST_END)
 #define AIO_VALIDATE(uptr)                                             \
     if (!pthread_equal ( pthread_self(), sim_asynch_main_threadid )) { \
       sim_printf("Improper thread context for operation on %s in %s line %d\n", \
@@ -1310,7 +1323,8 @@ extern int32 sim_asynch_inst_latency;
       } else (void)0
 #define AIO_CHECK_EVENT                                                \
     if (0 > --sim_asynch_check) {                                      \
-      AIO_UPDATE_QUEUE;                                                \
+      if (AIO_QUEUE_PENDING)                                           \
+        AIO_UPDATE_QUEUE;                                              \
       sim_asynch_check = sim_asynch_inst_latency;                      \
       } else (void)0
 #define AIO_SET_INTERRUPT_LATENCY(instpersec)                                                   \
@@ -52,6 +52,15 @@
    sim_buf_swap_data -       swap data elements inplace in buffer
    sim_shmem_open            create or attach to a shared memory region
    sim_shmem_close           close a shared memory region
+   sim_fmap_attach           map an attached unit's file into memory
+   sim_fmap_detach           write back and release a unit's file mapping
+   sim_fmap_ptr              address of a range of a mapped file
+   sim_fmap_dirty            note a write to a mapped file
+   sim_fmap_sync             write back a mapped file
+   sim_spool_attach          give an attached printer an output spool
+   sim_spool_write           add text or carriage control to a printer spool
+   sim_spool_flush           write a printer spool to its file
+   sim_spool_detach          write and release a printer spool
 
 
    sim_fopen and sim_fseek are OS-dependent.  The other routines are not.
@@ -64,6 +73,16 @@
 t_bool sim_end;                     /* TRUE = little endian, FALSE = big endian */
 t_bool sim_taddr_64;                /* t_addr is > 32b and Large File Support available */
 t_bool sim_toffset_64;              /* Large File (>2GB) file I/O Support available */
+t_uint64 sim_fio_ops = 0;           /* sim_fread and sim_fwrite calls, for SHOW BENCHMARK */
+
+/* Asynchronous I/O threads also call sim_fread and sim_fwrite */
+#if defined(SIM_ASYNCH_IO) && defined(_WIN32)
+#define FIO_OPS_INC     InterlockedIncrement64 ((LONGLONG volatile *)&sim_fio_ops)
+#elif defined(SIM_ASYNCH_IO) && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_8)
+#define FIO_OPS_INC     __sync_add_and_fetch (&sim_fio_ops, 1)
+#else
+#define FIO_OPS_INC     ++sim_fio_ops
+#endif
 
 #if defined(fprintf)                /* Make sure to only use the C rtl stream I/O routines */
 #undef fprintf
@@ -131,6 +150,7 @@ size_t c;
 
 if ((size == 0) || (count == 0))                        /* check arguments */
     return 0;
+FIO_OPS_INC;
 c = fread (bptr, size, count, fptr);                    /* read buffer */
 if (sim_end || (size == sizeof (char)) || (c == 0))     /* le, byte, or err? */
     return c;                                           /* done */
@@ -165,6 +185,7 @@ unsigned char *sim_flip;
 
 if ((size == 0) || (count == 0))                        /* check arguments */
     return 0;
+FIO_OPS_INC;
 if (sim_end || (size == sizeof (char)))                 /* le or byte? */
     return fwrite (bptr, size, count, fptr);            /* done */
 sim_flip = (unsigned char *)malloc(FLIP_SIZE);
@@ -478,6 +499,47 @@ t_bool sim_shmem_atomic_cas (int32 *ptr, int32 oldv, int32 newv)
 return (InterlockedCompareExchange ((LONG volatile *) ptr, newv, oldv) == oldv);
 }
 
+struct FMAP {
+    HANDLE hFile;
+    HANDLE hMapping;
+    uint8 *base;                        /* mapped file */
+    t_offset size;                      /* bytes mapped */
+    uint32 sync_time;                   /* sim_os_msec () at last sync */
+    t_bool dirty;                       /* written since last sync */
+    };
+
+static t_stat _sim_fmap_open (FILE *fptr, FMAP *fmap, t_bool rdonly)
+{
+t_uint64 size = (t_uint64)fmap->size;
+
+fmap->hFile = (HANDLE)_get_osfhandle (_fileno (fptr));
+fmap->hMapping = CreateFileMappingA (fmap->hFile, NULL, rdonly ? PAGE_WRITECOPY : PAGE_READWRITE,
+                                     (DWORD)(size >> 32), (DWORD)size, NULL);
+if (fmap->hMapping == NULL)
+    return sim_messagef (SCPE_OPENERR, "Can't CreateFileMapping() - LastError=0x%X\n", (unsigned int)GetLastError ());
+fmap->base = (uint8 *)MapViewOfFile (fmap->hMapping, rdonly ? FILE_MAP_COPY : FILE_MAP_WRITE, 0, 0, (SIZE_T)size);
+if (fmap->base == NULL) {
+    DWORD LastError = GetLastError ();
+
+    CloseHandle (fmap->hMapping);
+    return sim_messagef (SCPE_OPENERR, "Can't MapViewOfFile() - LastError=0x%X\n", (unsigned int)LastError);
+    }
+return SCPE_OK;
+}
+
+static void _sim_fmap_sync (FMAP *fmap, t_bool wait)
+{
+FlushViewOfFile (fmap->base, 0);
+if (wait)
+    FlushFileBuffers (fmap->hFile);
+}
+
+static void _sim_fmap_close (FMAP *fmap)
+{
+UnmapViewOfFile (fmap->base);
+CloseHandle (fmap->hMapping);
+}
+
 #else /* !defined(_WIN32) */
 #include <unistd.h>
 int sim_set_fsize (FILE *fptr, t_addr size)
@@ -670,6 +732,38 @@ else
 #endif
 }
 
+struct FMAP {
+    uint8 *base;                        /* mapped file */
+    t_offset size;                      /* bytes mapped */
+    uint32 sync_time;                   /* sim_os_msec () at last sync */
+    t_bool dirty;                       /* written since last sync */
+    };
+
+/* Read only files get a private mapping, so stray updates never reach the file */
+
+static t_stat _sim_fmap_open (FILE *fptr, FMAP *fmap, t_bool rdonly)
+{
+void *base;
+
+if ((t_offset)(size_t)fmap->size != fmap->size)
+    return sim_messagef (SCPE_OPENERR, "File too large to map\n");
+base = mmap (NULL, (size_t)fmap->size, PROT_READ | PROT_WRITE, rdonly ? MAP_PRIVATE : MAP_SHARED, fileno (fptr), 0);
+if (base == MAP_FAILED)
+    return sim_messagef (SCPE_OPENERR, "mmap() failed. errno=%d - %s\n", errno, strerror (errno));
+fmap->base = (uint8 *)base;
+return SCPE_OK;
+}
+
+static void _sim_fmap_sync (FMAP *fmap, t_bool wait)
+{
+msync (fmap->base, (size_t)fmap->size, wait ? MS_SYNC : MS_ASYNC);
+}
+
+static void _sim_fmap_close (FMAP *fmap)
+{
+munmap (fmap->base, (size_t)fmap->size);
+}
+
 #else /* !(defined (__linux__) || defined (__APPLE__)) */
 
 t_stat sim_shmem_open (const char *name, size_t size, SHMEM **shmem, void **addr)
@@ -691,9 +785,220 @@ t_bool sim_shmem_atomic_cas (int32 *ptr, int32 oldv, int32 newv)
 return FALSE;
 }
 
+struct FMAP {
+    uint8 *base;                        /* mapped file */
+    t_offset size;                      /* bytes mapped */
+    uint32 sync_time;                   /* sim_os_msec () at last sync */
+    t_bool dirty;                       /* written since last sync */
+    };
+
+static t_stat _sim_fmap_open (FILE *fptr, FMAP *fmap, t_bool rdonly)
+{
+return sim_messagef (SCPE_NOFNC, "File mapping not supported on this host\n");
+}
+
+static void _sim_fmap_sync (FMAP *fmap, t_bool wait)
+{
+}
+
+static void _sim_fmap_close (FMAP *fmap)
+{
+}
+
 #endif /* defined (__linux__) || defined (__APPLE__) */
 #endif /* defined (_WIN32) */
 
+/* Mapped disk images
+
+   A disk device attach routine calls sim_fmap_attach once the file is
+   open.  If the unit was attached with -M (or was mapped when it was
+   SAVEd) the whole image is mapped into memory and sim_fmap_ptr then
+   returns a direct pointer to any range of it, so sector transfers need
+   no seek, read or write calls.  A writable image is first extended to
+   the full size of the drive so every sector is mapped.  A read only
+   image shorter than the drive is mapped as is, sim_fmap_ptr returns
+   NULL beyond the end and the driver falls back to its normal file I/O.
+
+   Drivers call sim_fmap_dirty after storing into the mapping.  Changed
+   pages are written back by the host, and at least every
+   FMAP_SYNC_MSEC; detach_unit writes everything back and unmaps.
+   If the file can't be mapped the unit stays attached unmapped.
+*/
+
+#define FMAP_SYNC_MSEC  30000           /* Interval between background syncs */
+
+t_stat sim_fmap_attach (UNIT *uptr, t_offset size)
+{
+FMAP *fmap;
+t_offset fsize;
+t_bool rdonly = ((uptr->flags & UNIT_RO) != 0);
+t_stat r;
+
+if (sim_switches & SWMASK ('M'))                        /* map requested? */
+    uptr->dynflags |= UNIT_FMAP;
+else if (!(sim_switches & SIM_SW_REST))                 /* keep saved choice on RESTORE */
+    uptr->dynflags &= ~UNIT_FMAP;
+if (!(uptr->dynflags & UNIT_FMAP) ||
+    (uptr->fileref == NULL) ||
+    (uptr->dynflags & UNIT_NO_FIO))
+    return SCPE_OK;
+sim_fmap_detach (uptr);
+fflush (uptr->fileref);
+fsize = sim_fsize_ex (uptr->fileref);
+if (size > fsize) {                                     /* short image? */
+    if (rdonly)
+        size = fsize;                                   /* map what's there */
+    else if (sim_set_fsize (uptr->fileref, (t_addr)size)) {
+        return sim_messagef (SCPE_OK, "%s: can't extend %s to map it, using file I/O\n",
+                             sim_uname (uptr), uptr->filename);
+        }
+    }
+if (size <= 0)
+    return SCPE_OK;
+fmap = (FMAP *)calloc (1, sizeof (*fmap));
+if (fmap == NULL)
+    return SCPE_MEM;
+fmap->size = size;
+r = _sim_fmap_open (uptr->fileref, fmap, rdonly);
+if (r != SCPE_OK) {
+    free (fmap);
+    return sim_messagef (SCPE_OK, "%s: not mapped, using file I/O\n", sim_uname (uptr));
+    }
+fmap->sync_time = sim_os_msec ();
+uptr->fmap = fmap;
+return SCPE_OK;
+}
+
+void sim_fmap_detach (UNIT *uptr)
+{
+FMAP *fmap = (FMAP *)uptr->fmap;
+
+if (fmap == NULL)
+    return;
+uptr->fmap = NULL;
+if (!(uptr->flags & UNIT_RO))
+    _sim_fmap_sync (fmap, TRUE);
+_sim_fmap_close (fmap);
+free (fmap);
+}
+
+uint8 *sim_fmap_ptr (UNIT *uptr, t_offset offset, size_t len)
+{
+FMAP *fmap = (FMAP *)uptr->fmap;
+
+if ((fmap == NULL) || (offset < 0) || (offset + (t_offset)len > fmap->size))
+    return NULL;
+return fmap->base + (size_t)offset;
+}
+
+void sim_fmap_dirty (UNIT *uptr)
+{
+FMAP *fmap = (FMAP *)uptr->fmap;
+uint32 now;
+
+if (fmap == NULL)
+    return;
+fmap->dirty = TRUE;
+now = sim_os_msec ();
+if ((now - fmap->sync_time) >= FMAP_SYNC_MSEC) {        /* time for a background sync? */
+    _sim_fmap_sync (fmap, FALSE);
+    fmap->sync_time = now;
+    fmap->dirty = FALSE;
+    }
+}
+
+t_stat sim_fmap_sync (UNIT *uptr)
+{
+FMAP *fmap = (FMAP *)uptr->fmap;
+
+if (fmap == NULL)
+    return SCPE_OK;
+if (!(uptr->flags & UNIT_RO))
+    _sim_fmap_sync (fmap, TRUE);
+fmap->sync_time = sim_os_msec ();
+fmap->dirty = FALSE;
+return SCPE_OK;
+}
+
+/* Printer spooling
+
+   Printers write a line of text followed by a few carriage control
+   characters, and a stdio call for each of them costs far more than the
+   characters themselves.  A printer attach routine calls sim_spool_attach
+   once the file is open; sim_spool_write then copies into the spool and
+   advances uptr->pos.  The spool is written to the file in one block
+   when it fills, and sim_flush_buffered_files writes and fflushes it
+   along with the other attached files, i.e. when the simulator stops
+   and every 30 seconds while it runs,
+   asynch I/O or not.  detach_unit writes it out and frees it.  Writes
+   to a unit without a spool go straight to the file.
+*/
+
+#define SPOOL_SIZE      65536           /* Spool buffer size */
+
+struct SPOOL {
+    size_t              len;            /* Bytes waiting */
+    uint8               data[SPOOL_SIZE];
+    };
+
+t_stat sim_spool_attach (UNIT *uptr)
+{
+SPOOL *spool;
+
+sim_spool_detach (uptr);
+if ((uptr->fileref == NULL) ||
+    (uptr->dynflags & UNIT_NO_FIO))
+    return SCPE_OK;
+spool = (SPOOL *)calloc (1, sizeof (*spool));
+if (spool == NULL)
+    return SCPE_OK;                                     /* run unspooled */
+uptr->spool = spool;
+return SCPE_OK;
+}
+
+void sim_spool_write (UNIT *uptr, const void *bptr, size_t len)
+{
+SPOOL *spool = (SPOOL *)uptr->spool;
+
+uptr->pos += (t_addr)len;
+if (spool == NULL) {
+    sim_fwrite (bptr, 1, len, uptr->fileref);
+    return;
+    }
+if (spool->len + len > SPOOL_SIZE) {
+    sim_fwrite (spool->data, 1, spool->len, uptr->fileref);
+    spool->len = 0;
+    if (len > SPOOL_SIZE) {
+        sim_fwrite (bptr, 1, len, uptr->fileref);
+        return;
+        }
+    }
+memcpy (spool->data + spool->len, bptr, len);
+spool->len += len;
+}
+
+void sim_spool_flush (UNIT *uptr)
+{
+SPOOL *spool = (SPOOL *)uptr->spool;
+
+if (spool != NULL) {
+    if (spool->len)
+        sim_fwrite (spool->data, 1, spool->len, uptr->fileref);
+    spool->len = 0;
+    }
+if (uptr->fileref)
+    fflush (uptr->fileref);
+}
+
+void sim_spool_detach (UNIT *uptr)
+{
+if (uptr->spool == NULL)
+    return;
+sim_spool_flush (uptr);
+free (uptr->spool);
+uptr->spool = NULL;
+}
+
 #if defined(__VAX)
 /* 
  * We privide a 'basic' snprintf, which 'might' overrun a buffer, but
@@ -88,10 +88,22 @@ t_stat sim_shmem_open (const char *name, size_t size, SHMEM **shmem, void **addr
 void sim_shmem_close (SHMEM *shmem);
 int32 sim_shmem_atomic_add (int32 *ptr, int32 val);
 t_bool sim_shmem_atomic_cas (int32 *ptr, int32 oldv, int32 newv);
+typedef struct FMAP FMAP;
+t_stat sim_fmap_attach (UNIT *uptr, t_offset size);
+void sim_fmap_detach (UNIT *uptr);
+uint8 *sim_fmap_ptr (UNIT *uptr, t_offset offset, size_t len);
+void sim_fmap_dirty (UNIT *uptr);
+t_stat sim_fmap_sync (UNIT *uptr);
+typedef struct SPOOL SPOOL;
+t_stat sim_spool_attach (UNIT *uptr);
+void sim_spool_write (UNIT *uptr, const void *bptr, size_t len);
+void sim_spool_flush (UNIT *uptr);
+void sim_spool_detach (UNIT *uptr);
 
 extern t_bool sim_taddr_64;         /* t_addr is > 32b and Large File Support available */
 extern t_bool sim_toffset_64;       /* Large File (>2GB) file I/O support */
 extern t_bool sim_end;              /* TRUE = little endian, FALSE = big endian */
+extern t_uint64 sim_fio_ops;        /* File I/O calls */
 
 #ifdef  __cplusplus
 }
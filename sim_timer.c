@@ -64,6 +64,7 @@
    sim_rtc_init -           initialize calibration
    sim_rtc_calb -           calibrate clock
    sim_idle -               virtual machine idle
+   sim_set_fastio -         skip to next event when idle
    sim_os_msec  -           return elapsed time in msec
    sim_os_sleep -           sleep specified number of seconds
    sim_os_ms_sleep -        sleep specified number of milliseconds
@@ -99,6 +100,7 @@
 #endif
 
 uint32 sim_idle_ms_sleep (unsigned int msec);
+uint32 sim_idle_us_sleep (uint32 usec);
 
 /* MS_MIN_GRANULARITY exists here so that timing behavior for hosts systems  */
 /* with slow clock ticks can be assessed and tested without actually having  */
@@ -108,6 +110,7 @@ uint32 sim_idle_ms_sleep (unsigned int msec);
 
 #if defined(MS_MIN_GRANULARITY) && (MS_MIN_GRANULARITY != 1)
 uint32 real_sim_idle_ms_sleep (unsigned int msec);
+uint32 real_sim_idle_us_sleep (uint32 usec);
 uint32 real_sim_os_msec (void);
 uint32 real_sim_os_ms_sleep (unsigned int msec);
 static uint32 real_sim_os_sleep_min_ms = 0;
@@ -133,6 +136,11 @@ else
 return (sim_os_msec () - start);
 }
 
+uint32 sim_idle_us_sleep (uint32 usec)
+{
+return 1000 * sim_idle_ms_sleep ((usec + 999) / 1000);
+}
+
 uint32 sim_os_msec (void)
 {
 return (real_sim_os_msec ()/MS_MIN_GRANULARITY)*MS_MIN_GRANULARITY;
@@ -149,6 +157,8 @@ return real_sim_os_ms_sleep (msec);
 
 t_bool sim_idle_enab = FALSE;                       /* global flag */
 volatile t_bool sim_idle_wait = FALSE;              /* global flag */
+t_bool sim_fastio_enab = FALSE;                     /* global flag */
+static uint32 sim_fastio_skips = 0;                 /* times idle skipped ahead */
 
 int32 sim_vm_initial_ips = SIM_INITIAL_IPS;
 
@@ -162,6 +172,7 @@ double sim_time_at_sim_prompt =  0;                 /* time spent processing com
 static uint32 sim_idle_rate_ms = 0;                 /* Minimum Sleep time */
 static uint32 sim_os_sleep_min_ms = 0;
 static uint32 sim_os_sleep_inc_ms = 0;
+static uint32 sim_os_sleep_min_us = 0;              /* shortest host sleep (usecs) */
 static uint32 sim_os_clock_resoluton_ms = 0;
 static uint32 sim_os_tick_hz = 0;
 static uint32 sim_idle_stable = SIM_IDLE_STDFLT;
@@ -177,9 +188,13 @@ static uint32 sim_throt_state = SIM_THROT_STATE_INIT;
 static double sim_throt_cps;
 static double sim_throt_peak_cps;
 static double sim_throt_inst_start;
-static uint32 sim_throt_sleep_time = 0;
+static uint32 sim_throt_sleep_time = 0;            /* usecs */
 static int32 sim_throt_wait = 0;
 static uint32 sim_throt_delay = 3;
+static uint32 sim_sleep_count = 0;                  /* timed out sleeps measured */
+static double sim_sleep_over_tot = 0;               /* total sleep overshoot (usecs) */
+static uint32 sim_sleep_over_max = 0;               /* worst sleep overshoot (usecs) */
+static double sim_sleep_over_avg = 0;               /* running average overshoot (usecs) */
 #define CLK_TPS 100
 #define CLK_INIT (sim_precalibrate_ips/CLK_TPS)
 static int32 sim_int_clk_tps;
@@ -220,7 +235,10 @@ typedef struct RTC {
     t_bool clock_catchup_eligible;  /* clock tick catchup eligible */
     uint32 clock_time_idled;        /* total time idled */
     uint32 clock_time_idled_last;   /* total time idled as of the previous second */
+    uint32 clock_time_idled_us;     /* idle usecs not yet counted in clock_time_idled */
     uint32 clock_calib_skip_idle;   /* Calibrations skipped due to idling */
+    uint32 clock_fastio_skips;      /* sim_fastio_skips at the last calibration */
+    uint32 clock_calib_skip_fastio; /* Calibrations skipped due to fast I/O */
     uint32 clock_calib_gap2big;     /* Calibrations skipped Gap Too Big */
     uint32 clock_calib_backwards;   /* Calibrations skipped Clock Running Backwards */
     } RTC;
@@ -272,29 +290,56 @@ for (i = 0, tot = 0; i < sleep1Samples; i++)
     tot += sim_idle_ms_sleep (sim_os_sleep_min_ms + 1);
 tim = tot / sleep1Samples;          /* Truncated average */
 sim_os_sleep_inc_ms = tim - sim_os_sleep_min_ms;
+/* Shortest sleep actually available, asking for 100us */
+for (i = 0, tot = 0; i < sleep1Samples; i++)
+    tot += sim_idle_us_sleep (100);
+sim_os_sleep_min_us = tot / sleep1Samples;
+if (sim_os_sleep_min_us < 100)
+    sim_os_sleep_min_us = 100;
+if ((sim_os_sleep_min_ms != 0) && (sim_os_sleep_min_us > 1000 * sim_os_sleep_min_ms))
+    sim_os_sleep_min_us = 1000 * sim_os_sleep_min_ms;
 sim_os_set_thread_priority (PRIORITY_NORMAL);
+/* Keep the running overshoot average as a starting point, */
+/* the statistics only cover sleeps while simulating */
+sim_sleep_count = 0;
+sim_sleep_over_tot = 0;
+sim_sleep_over_max = 0;
 return sim_os_sleep_min_ms;
 }
 
 #if defined(MS_MIN_GRANULARITY) && (MS_MIN_GRANULARITY != 1)
 
 #define sim_idle_ms_sleep   real_sim_idle_ms_sleep 
+#define sim_idle_us_sleep   real_sim_idle_us_sleep
 #define sim_os_msec         real_sim_os_msec 
 #define sim_os_ms_sleep     real_sim_os_ms_sleep
 
 #endif /* defined(MS_MIN_GRANULARITY) && (MS_MIN_GRANULARITY != 1) */
 
+/* Record how far a sleep ran past the requested time.  The running  */
+/* average lets the throttle ask for a little less than it wants.     */
+static void _sleep_record (uint32 req_us, uint32 act_us)
+{
+uint32 over = (act_us > req_us) ? act_us - req_us : 0;
+
+++sim_sleep_count;
+sim_sleep_over_tot += over;
+if (over > sim_sleep_over_max)
+    sim_sleep_over_max = over;
+sim_sleep_over_avg += (over - sim_sleep_over_avg) / 16;
+}
+
 #if defined(SIM_ASYNCH_IO)
-uint32 sim_idle_ms_sleep (unsigned int msec)
+uint32 sim_idle_us_sleep (uint32 usec)
 {
 struct timespec start_time, end_time, done_time, delta_time;
-uint32 delta_ms;
+uint32 delta_us;
 t_bool timedout = FALSE;
 
 clock_gettime(CLOCK_REALTIME, &start_time);
 end_time = start_time;
-end_time.tv_sec += (msec/1000);
-end_time.tv_nsec += 1000000*(msec%1000);
+end_time.tv_sec += (usec/1000000);
+end_time.tv_nsec += 1000*(usec%1000000);
 if (end_time.tv_nsec >= 1000000000) {
   end_time.tv_sec += end_time.tv_nsec/1000000000;
   end_time.tv_nsec = end_time.tv_nsec%1000000000;
@@ -312,16 +357,49 @@ if (!timedout) {
     AIO_UPDATE_QUEUE;
     }
 sim_timespec_diff (&delta_time, &done_time, &start_time);
-delta_ms = (uint32)((delta_time.tv_sec * 1000) + ((delta_time.tv_nsec + 500000) / 1000000));
-return delta_ms;
+delta_us = (uint32)((delta_time.tv_sec * 1000000) + ((delta_time.tv_nsec + 500) / 1000));
+if (timedout)                             /* woken early by I/O isn't overshoot */
+    _sleep_record (usec, delta_us);
+return delta_us;
+}
+#elif defined(CLOCK_MONOTONIC) && defined(TIMER_ABSTIME)
+uint32 sim_idle_us_sleep (uint32 usec)
+{
+struct timespec start_time, end_time, done_time, delta_time;
+uint32 delta_us;
+
+clock_gettime(CLOCK_MONOTONIC, &start_time);
+end_time = start_time;
+end_time.tv_sec += (usec/1000000);
+end_time.tv_nsec += 1000*(usec%1000000);
+if (end_time.tv_nsec >= 1000000000) {
+  end_time.tv_sec += end_time.tv_nsec/1000000000;
+  end_time.tv_nsec = end_time.tv_nsec%1000000000;
+  }
+/* An absolute deadline doesn't drift when a signal interrupts the sleep */
+while (clock_nanosleep (CLOCK_MONOTONIC, TIMER_ABSTIME, &end_time, NULL) == EINTR)
+    ;
+clock_gettime(CLOCK_MONOTONIC, &done_time);
+sim_timespec_diff (&delta_time, &done_time, &start_time);
+delta_us = (uint32)((delta_time.tv_sec * 1000000) + ((delta_time.tv_nsec + 500) / 1000));
+_sleep_record (usec, delta_us);
+return delta_us;
 }
 #else
-uint32 sim_idle_ms_sleep (unsigned int msec)
+uint32 sim_idle_us_sleep (uint32 usec)
 {
-return sim_os_ms_sleep (msec);
+uint32 delta_us = 1000 * sim_os_ms_sleep ((usec + 999) / 1000);
+
+_sleep_record (usec, delta_us);
+return delta_us;
 }
 #endif
 
+uint32 sim_idle_ms_sleep (unsigned int msec)
+{
+return (sim_idle_us_sleep (1000 * msec) + 500) / 1000;
+}
+
 /* Mark the need for the sim_os_set_thread_priority routine, */
 /* allowing the feature and/or platform dependent code to provide it */
 #define NEED_THREAD_PRIORITY
@@ -725,6 +803,7 @@ return SCPE_OK;
 #if defined(MS_MIN_GRANULARITY) && (MS_MIN_GRANULARITY != 1)
 /* Make sure to use the substitute routines */
 #undef sim_idle_ms_sleep
+#undef sim_idle_us_sleep
 #undef sim_os_msec
 #undef sim_os_ms_sleep
 #endif /* defined(MS_MIN_GRANULARITY) && (MS_MIN_GRANULARITY != 1) */
@@ -1031,6 +1110,19 @@ if (delta_rtime > 30000) {                          /* gap too big? */
     sim_debug (DBG_CAL, &sim_timer_dev, "gap too big: delta = %d - result: %d\n", delta_rtime, rtc->currd);
     return rtc->currd;                              /* can't calibr */
     }
+if (rtc->clock_fastio_skips != sim_fastio_skips) {  /* skipped ahead in this second? */
+    /* Simulated time ran faster than wall time, so the instruction */
+    /* rate seen here says nothing about the host.  Keep the current */
+    /* tick size as the gap too big case does.                       */
+    rtc->clock_fastio_skips = sim_fastio_skips;
+    ++rtc->clock_calib_skip_fastio;                 /* Count statistic */
+    rtc->vtime = rtc->rtime;                        /* sync virtual and real time */
+    rtc->nxintv = 1000;                             /* reset next interval */
+    rtc->gtime = sim_gtime();                       /* save instruction time */
+    rtc->based = rtc->currd;
+    sim_debug (DBG_CAL, &sim_timer_dev, "skipping calibration due to fast I/O - result: %d\n", rtc->currd);
+    return rtc->currd;                              /* can't calibr */
+    }
 last_idle_pct = 0;                                  /* normally force calibration */
 if (tmr != SIM_NTIMERS) {
     if (delta_rtime != 0)                           /* avoid divide by zero  */
@@ -1050,7 +1142,7 @@ new_gtime = sim_gtime();
 if ((last_idle_pct == 0) && (delta_rtime != 0)) {
     sim_idle_cyc_ms = (uint32)((new_gtime - rtc->gtime) / delta_rtime);
     if ((sim_idle_rate_ms != 0) && (delta_rtime > 1))
-        sim_idle_cyc_sleep = (uint32)((new_gtime - rtc->gtime) / (delta_rtime / sim_idle_rate_ms));
+        sim_idle_cyc_sleep = (uint32)(((new_gtime - rtc->gtime) * sim_os_sleep_min_us) / (1000.0 * delta_rtime));
     }
 if (sim_asynch_timer || (catchup_ticks_curr > 0)) {
     /* An asynchronous clock or when catchup ticks have  */
@@ -1147,6 +1239,7 @@ sim_register_internal_device (&sim_throttle_dev);       /* Register Throttle Dev
 sim_throttle_unit.action = &sim_throt_svc;
 sim_register_clock_unit_tmr (&SIM_INTERNAL_UNIT, SIM_INTERNAL_CLK);
 sim_idle_enab = FALSE;                                  /* init idle off */
+sim_fastio_enab = FALSE;                                /* init fast I/O off */
 sim_idle_rate_ms = sim_os_ms_sleep_init ();             /* get OS timer rate */
 sim_set_rom_delay_factor (sim_get_rom_delay_factor ()); /* initialize ROM delay factor */
 
@@ -1196,11 +1289,19 @@ fprintf (st, "Minimum Host Sleep Time:        %d ms (%dHz)\n", sim_os_sleep_min_
 if (sim_os_sleep_min_ms != sim_os_sleep_inc_ms)
     fprintf (st, "Minimum Host Sleep Incr Time:   %d ms\n", sim_os_sleep_inc_ms);
 fprintf (st, "Host Clock Resolution:          %d ms\n", sim_os_clock_resoluton_ms);
+fprintf (st, "Minimum Host usec Sleep Time:   %d us\n", sim_os_sleep_min_us);
+if (sim_sleep_count) {
+    fprintf (st, "Host Sleeps:                    %s\n", sim_fmt_numeric ((double)sim_sleep_count));
+    fprintf (st, "Host Sleep Overshoot:           %.0f us average, %u us max, %.0f us recent\n", 
+                 sim_sleep_over_tot / sim_sleep_count, sim_sleep_over_max, sim_sleep_over_avg);
+    }
 fprintf (st, "Execution Rate:                 %s %s/sec\n", sim_fmt_numeric (inst_per_sec), sim_vm_interval_units);
 if (sim_idle_enab) {
     fprintf (st, "Idling:                         Enabled\n");
     fprintf (st, "Time before Idling starts:      %d seconds\n", sim_idle_stable);
     }
+if (sim_fastio_enab)
+    fprintf (st, "Fast I/O:                       Enabled\n");
 if (sim_throt_type != SIM_THROT_NONE) {
     sim_show_throt (st, NULL, uptr, val, desc);
     }
@@ -1252,6 +1353,8 @@ for (tmr=clocks=0; tmr<=SIM_NTIMERS; ++tmr) {
             fprintf (st, "  Calib Skip when Idle >:    %u%%\n",   sim_idle_calib_pct);
         if (rtc->clock_calib_skip_idle)
             fprintf (st, "  Calibs Skip While Idle:    %s\n",   sim_fmt_numeric ((double)rtc->clock_calib_skip_idle));
+        if (rtc->clock_calib_skip_fastio)
+            fprintf (st, "  Calibs Skip Fast I/O:      %s\n",   sim_fmt_numeric ((double)rtc->clock_calib_skip_fastio));
         if (rtc->clock_calib_backwards)
             fprintf (st, "  Calibs Skip Backwards:     %s\n",   sim_fmt_numeric ((double)rtc->clock_calib_backwards));
         if (rtc->clock_calib_gap2big)
@@ -1415,7 +1518,7 @@ REG sim_throttle_reg[] = {
     { DRDATAD (THROT_TYPE,       sim_throt_type,         32, "Throttle type"), PV_RSPC|REG_RO},
     { DRDATAD (THROT_VAL,        sim_throt_val,          32, "Throttle mode value"), PV_RSPC|REG_RO},
     { DRDATAD (THROT_STATE,      sim_throt_state,        32, "Throttle state"), PV_RSPC|REG_RO},
-    { DRDATAD (THROT_SLEEP_TIME, sim_throt_sleep_time,   32, "Throttle sleep time"), PV_RSPC|REG_RO},
+    { DRDATAD (THROT_SLEEP_TIME, sim_throt_sleep_time,   32, "Throttle sleep time (usecs)"), PV_RSPC|REG_RO},
     { DRDATAD (THROT_WAIT,       sim_throt_wait,         32, "Throttle execution interval before sleep"), PV_RSPC|REG_RO},
     { DRDATAD (THROT_DELAY,      sim_throt_delay,        32, "Seconds before throttling starts"), PV_RSPC},
     { DRDATAD (THROT_DRIFT_PCT,  sim_throt_drift_pct,    32, "Percent of throttle drift before correction"), PV_RSPC},
@@ -1621,7 +1724,7 @@ return SCPE_OK;
 
 t_bool sim_idle (uint32 tmr, int sin_cyc)
 {
-uint32 w_ms, w_idle, act_ms;
+uint32 w_us, w_idle, act_us;
 int32 act_cyc;
 static t_bool in_nowait = FALSE;
 double cyc_since_idle;
@@ -1640,6 +1743,17 @@ if (_rtcn_tick_catchup_check (rtc, -1)) {               /* Check for slow clock
     sim_interval -= sin_cyc;
     return FALSE;
     }
+if (sim_fastio_enab) {                                  /* fast I/O? */
+    /* Nothing can happen until the next event, so rather than waiting */
+    /* it out, in host time or in simulated cycles, make it due now.   */
+    if (sim_clock_queue == QUEUE_LIST_END)
+        sim_debug (DBG_IDL, &sim_timer_dev, "fast I/O skipping %d %s - no pending event\n", sim_interval, sim_vm_interval_units);
+    else
+        sim_debug (DBG_IDL, &sim_timer_dev, "fast I/O skipping %d %s to event on %s\n", sim_interval, sim_vm_interval_units, sim_uname(sim_clock_queue));
+    ++sim_fastio_skips;
+    sim_interval = 0;
+    return TRUE;
+    }
 if ((!sim_idle_enab)                             ||     /* idling disabled */
     ((sim_clock_queue == QUEUE_LIST_END) &&             /* or clock queue empty? */
      (!sim_asynch_timer))||                             /*     and not asynch? */
@@ -1680,14 +1794,14 @@ sim_debug (DBG_TRC, &sim_timer_dev, "sim_idle(tmr=%d, sin_cyc=%d)\n", tmr, sin_c
 if (sim_idle_cyc_ms == 0) {
     sim_idle_cyc_ms = (rtc->currd * rtc->hz) / 1000;/* cycles per msec */
     if (sim_idle_rate_ms != 0)
-        sim_idle_cyc_sleep = (rtc->currd * rtc->hz) / (1000 / sim_idle_rate_ms);/* cycles per minimum sleep */
+        sim_idle_cyc_sleep = (uint32)(((double)rtc->currd * rtc->hz * sim_os_sleep_min_us) / 1000000.0);/* cycles per minimum sleep */
     }
 if ((sim_idle_rate_ms == 0) || (sim_idle_cyc_ms == 0)) {/* not possible? */
     sim_interval -= sin_cyc;
     sim_debug (DBG_IDL, &sim_timer_dev, "not possible idle_rate_ms=%d - cyc/ms=%d\n", sim_idle_rate_ms, sim_idle_cyc_ms);
     return FALSE;
     }
-w_ms = (uint32) sim_interval / sim_idle_cyc_ms;         /* ms to wait */
+w_us = (uint32)((1000.0 * sim_interval) / sim_idle_cyc_ms);/* usecs to wait */
 /* When the host system has a clock tick which is less frequent than the    */
 /* simulated system's clock, idling will cause delays which will miss       */
 /* simulated clock ticks.  To accomodate this, and still allow idling, if   */
@@ -1696,25 +1810,27 @@ w_ms = (uint32) sim_interval / sim_idle_cyc_ms;         /* ms to wait */
 if (rtc->clock_catchup_eligible)
     w_idle = (sim_interval * 1000) / rtc->currd;        /* 1000 * pending fraction of tick */
 else
-    w_idle = (w_ms * 1000) / sim_idle_rate_ms;          /* 1000 * intervals to wait */
-if ((w_idle < 500) || (w_ms == 0)) {                    /* shorter than 1/2 the interval or */
+    w_idle = (uint32)(((t_uint64)w_us * 1000) / sim_os_sleep_min_us);/* 1000 * intervals to wait */
+if ((w_idle < 500) || (w_us == 0)) {                    /* shorter than 1/2 the interval or */
     sim_interval -= sin_cyc;                            /* minimal sleep time? */
     if (!in_nowait)
         sim_debug (DBG_IDL, &sim_timer_dev, "no wait, too short: %d usecs\n", w_idle);
     in_nowait = TRUE;
     return FALSE;
     }
-if (w_ms > 1000)                                        /* too long a wait (runaway calibration) */
-    sim_debug (DBG_TIK, &sim_timer_dev, "waiting too long: w_ms=%d usecs, w_idle=%d usecs, sim_interval=%d, rtc->currd=%d\n", w_ms, w_idle, sim_interval, rtc->currd);
+if (w_us > 1000000)                                     /* too long a wait (runaway calibration) */
+    sim_debug (DBG_TIK, &sim_timer_dev, "waiting too long: w_us=%d usecs, w_idle=%d usecs, sim_interval=%d, rtc->currd=%d\n", w_us, w_idle, sim_interval, rtc->currd);
 in_nowait = FALSE;
 if (sim_clock_queue == QUEUE_LIST_END)
-    sim_debug (DBG_IDL, &sim_timer_dev, "sleeping for %d ms - pending event in %d %s\n", w_ms, sim_interval, sim_vm_interval_units);
+    sim_debug (DBG_IDL, &sim_timer_dev, "sleeping for %d us - pending event in %d %s\n", w_us, sim_interval, sim_vm_interval_units);
 else
-    sim_debug (DBG_IDL, &sim_timer_dev, "sleeping for %d ms - pending event on %s in %d %s\n", w_ms, sim_uname(sim_clock_queue), sim_interval, sim_vm_interval_units);
+    sim_debug (DBG_IDL, &sim_timer_dev, "sleeping for %d us - pending event on %s in %d %s\n", w_us, sim_uname(sim_clock_queue), sim_interval, sim_vm_interval_units);
 cyc_since_idle = sim_gtime() - sim_idle_end_time;       /* time since prior idle */
-act_ms = sim_idle_ms_sleep (w_ms);                      /* wait */
-rtc->clock_time_idled += act_ms;
-act_cyc = act_ms * sim_idle_cyc_ms;
+act_us = sim_idle_us_sleep (w_us);                      /* wait */
+rtc->clock_time_idled_us += act_us;
+rtc->clock_time_idled += rtc->clock_time_idled_us / 1000;
+rtc->clock_time_idled_us %= 1000;
+act_cyc = (int32)(((double)act_us * sim_idle_cyc_ms) / 1000.0);
 if (cyc_since_idle > sim_idle_cyc_sleep)
     act_cyc -= sim_idle_cyc_sleep / 2;                  /* account for half an interval's worth of cycles */
 else
@@ -1722,9 +1838,9 @@ else
 sim_interval = sim_interval - act_cyc;                  /* count down sim_interval to reflect idle period */
 sim_idle_end_time = sim_gtime();                        /* save idle completed time */
 if (sim_clock_queue == QUEUE_LIST_END)
-    sim_debug (DBG_IDL, &sim_timer_dev, "slept for %d ms - pending event in %d %s\n", act_ms, sim_interval, sim_vm_interval_units);
+    sim_debug (DBG_IDL, &sim_timer_dev, "slept for %d us - pending event in %d %s\n", act_us, sim_interval, sim_vm_interval_units);
 else
-    sim_debug (DBG_IDL, &sim_timer_dev, "slept for %d ms - pending event on %s in %d %s\n", act_ms, sim_uname(sim_clock_queue), sim_interval, sim_vm_interval_units);
+    sim_debug (DBG_IDL, &sim_timer_dev, "slept for %d us - pending event on %s in %d %s\n", act_us, sim_uname(sim_clock_queue), sim_interval, sim_vm_interval_units);
 return TRUE;
 }
 
@@ -1770,6 +1886,38 @@ if (sim_switches & SWMASK ('D'))
 return SCPE_OK;
 }
 
+/* Set fast I/O - when the simulated CPU idles, skip straight to the next
+   event instead of sleeping.  Simulated time then runs as fast as the host
+   allows while the CPU waits on I/O, so throttling is disabled. */
+
+t_stat sim_set_fastio (UNIT *uptr, int32 val, CONST char *cptr, void *desc)
+{
+if (cptr && *cptr)
+    return SCPE_2MARG;
+sim_fastio_enab = TRUE;
+if (sim_throt_type != SIM_THROT_NONE) {
+    sim_set_throt (0, NULL);
+    sim_printf ("Throttling disabled\n");
+    }
+return SCPE_OK;
+}
+
+/* Clear fast I/O */
+
+t_stat sim_clr_fastio (UNIT *uptr, int32 val, CONST char *cptr, void *desc)
+{
+sim_fastio_enab = FALSE;
+return SCPE_OK;
+}
+
+/* Show fast I/O */
+
+t_stat sim_show_fastio (FILE *st, UNIT *uptr, int32 val, CONST void *desc)
+{
+fprintf (st, sim_fastio_enab ? "fast I/O" : "true I/O timing");
+return SCPE_OK;
+}
+
 /* Throttling package */
 
 t_stat sim_set_throt (int32 arg, CONST char *cptr)
@@ -1793,7 +1941,7 @@ else {
     val = strtotv (cptr, &tptr, 10);
     if (cptr == tptr)
         return sim_messagef (SCPE_ARG, "Invalid throttle specification: %s\n", cptr);
-    sim_throt_sleep_time = sim_idle_rate_ms;
+    sim_throt_sleep_time = sim_os_sleep_min_us;
     c = (char)toupper (*tptr++);
     if (c == '/') {
         val2 = strtotv (tptr, &tptr, 10);
@@ -1813,17 +1961,21 @@ else {
         sim_printf ("Idling disabled\n");
         sim_clr_idle (NULL, 0, NULL, NULL);
         }
+    if (sim_fastio_enab) {
+        sim_printf ("Fast I/O disabled\n");
+        sim_clr_fastio (NULL, 0, NULL, NULL);
+        }
     sim_throt_val = (uint32) val;
     if (sim_throt_type == SIM_THROT_SPC) {
         if (val2 >= sim_idle_rate_ms)
-            sim_throt_sleep_time = (uint32) val2;
+            sim_throt_sleep_time = 1000 * (uint32) val2;
         else {
             if ((sim_idle_rate_ms % val2) == 0) {
-                sim_throt_sleep_time = sim_idle_rate_ms;
+                sim_throt_sleep_time = 1000 * sim_idle_rate_ms;
                 sim_throt_val = (uint32) (val * (sim_idle_rate_ms / val2));
                 }
             else {
-                sim_throt_sleep_time = sim_idle_rate_ms;
+                sim_throt_sleep_time = 1000 * sim_idle_rate_ms;
                 sim_throt_val = (uint32) (val * (1 + (sim_idle_rate_ms / val2)));
                 }
             }
@@ -1832,7 +1984,7 @@ else {
         }
     }
 if (sim_throt_type == SIM_THROT_SPC)    /* Set initial value while correct one is determined */
-    sim_throt_cps = (int32)((1000.0 * sim_throt_val) / (double)sim_throt_sleep_time);
+    sim_throt_cps = (int32)((1000000.0 * sim_throt_val) / (double)sim_throt_sleep_time);
 else
     sim_throt_cps = sim_precalibrate_ips;
 return SCPE_OK;
@@ -1848,27 +2000,27 @@ else {
     case SIM_THROT_MCYC:
         fprintf (st, "Throttle:                      %d mega%s\n", sim_throt_val, sim_vm_interval_units);
         if (sim_throt_wait)
-            fprintf (st, "Throttling by sleeping for:    %d ms every %d %s\n", sim_throt_sleep_time, sim_throt_wait, sim_vm_interval_units);
+            fprintf (st, "Throttling by sleeping for:    %d us every %d %s\n", sim_throt_sleep_time, sim_throt_wait, sim_vm_interval_units);
         break;
 
     case SIM_THROT_KCYC:
         fprintf (st, "Throttle:                      %d kilo%s\n", sim_throt_val, sim_vm_interval_units);
         if (sim_throt_wait)
-            fprintf (st, "Throttling by sleeping for:    %d ms every %d %s\n", sim_throt_sleep_time, sim_throt_wait, sim_vm_interval_units);
+            fprintf (st, "Throttling by sleeping for:    %d us every %d %s\n", sim_throt_sleep_time, sim_throt_wait, sim_vm_interval_units);
         break;
 
     case SIM_THROT_PCT:
         if (sim_throt_wait) {
             fprintf (st, "Throttle:                      %d%% of %s %s per second\n", sim_throt_val, sim_fmt_numeric (sim_throt_peak_cps), sim_vm_interval_units);
-            fprintf (st, "Throttling by sleeping for:    %d ms every %d %s\n", sim_throt_sleep_time, sim_throt_wait, sim_vm_interval_units);
+            fprintf (st, "Throttling by sleeping for:    %d us every %d %s\n", sim_throt_sleep_time, sim_throt_wait, sim_vm_interval_units);
             }
         else
             fprintf (st, "Throttle:                      %d%%\n", sim_throt_val);
         break;
 
     case SIM_THROT_SPC:
-        fprintf (st, "Throttle:                      %d/%d\n", sim_throt_val, sim_throt_sleep_time);
-        fprintf (st, "Throttling by sleeping for:    %d ms every %d %s\n", sim_throt_sleep_time, sim_throt_val, sim_vm_interval_units);
+        fprintf (st, "Throttle:                      %d/%d\n", sim_throt_val, sim_throt_sleep_time / 1000);
+        fprintf (st, "Throttling by sleeping for:    %d us every %d %s\n", sim_throt_sleep_time, sim_throt_val, sim_vm_interval_units);
         break;
 
     default:
@@ -1906,6 +2058,19 @@ void sim_throt_cancel (void)
 sim_cancel (&sim_throttle_unit);
 }
 
+/* Throttle sleep request, shortened by the typical host overshoot
+   (but never by more than half) so the time actually slept stays
+   close to sim_throt_sleep_time */
+static uint32 _throt_sleep_us (void)
+{
+uint32 usec = sim_throt_sleep_time;
+uint32 adj = (uint32)sim_sleep_over_avg;
+
+if (adj > usec / 2)
+    adj = usec / 2;
+return usec - adj;
+}
+
 /* Throttle service
 
    Throttle service has three distinct states used while dynamically
@@ -1962,7 +2127,7 @@ switch (sim_throt_state) {
         else {                                          /* Non dynamic? */
             sim_throt_wait = sim_throt_val;
             sim_throt_state = SIM_THROT_STATE_THROTTLE; /* force state */
-            sim_throt_cps = (int32)((1000.0 * sim_throt_val) / (double)sim_throt_sleep_time);
+            sim_throt_cps = (int32)((1000000.0 * sim_throt_val) / (double)sim_throt_sleep_time);
             }
         sim_debug (DBG_THR, &sim_timer_dev, "sim_throt_svc(INIT) Starting.  Values wait = %d\n", sim_throt_wait);
         break;                                          /* reschedule */
@@ -2008,17 +2173,17 @@ switch (sim_throt_state) {
             while (1) {
                 sim_throt_wait = (int32)                /* cycles between sleeps */
                     ((a_cps * d_cps * ((double) sim_throt_sleep_time)) /
-                     (1000.0 * (a_cps - d_cps)));
+                     (1000000.0 * (a_cps - d_cps)));
                 if (sim_throt_wait >= SIM_THROT_WMIN)   /* long enough? */
                     break;
-                sim_throt_sleep_time += sim_os_sleep_inc_ms;
-                sim_debug (DBG_THR, &sim_timer_dev, "sim_throt_svc() Wait too small, increasing sleep time to %d ms.  Values a_cps = %f, d_cps = %f, wait = %d\n", 
+                sim_throt_sleep_time += sim_os_sleep_min_us;
+                sim_debug (DBG_THR, &sim_timer_dev, "sim_throt_svc() Wait too small, increasing sleep time to %d us.  Values a_cps = %f, d_cps = %f, wait = %d\n", 
                                                     sim_throt_sleep_time, a_cps, d_cps, sim_throt_wait);
                 }
             sim_throt_ms_start = sim_throt_ms_stop;
             sim_throt_inst_start = sim_gtime();
             sim_throt_state = SIM_THROT_STATE_THROTTLE;
-            sim_debug (DBG_THR, &sim_timer_dev, "sim_throt_svc() Throttle values a_cps = %f, d_cps = %f, wait = %d, sleep = %d ms\n", 
+            sim_debug (DBG_THR, &sim_timer_dev, "sim_throt_svc() Throttle values a_cps = %f, d_cps = %f, wait = %d, sleep = %d us\n", 
                                                 a_cps, d_cps, sim_throt_wait, sim_throt_sleep_time);
             sim_throt_cps = d_cps;                  /* save the desired rate */
             /* Run through all timers and adjust the calibration for each */
@@ -2040,7 +2205,7 @@ switch (sim_throt_state) {
         break;
 
     case SIM_THROT_STATE_THROTTLE:                      /* throttling */
-        sim_idle_ms_sleep (sim_throt_sleep_time);
+        sim_idle_us_sleep (_throt_sleep_us ());
         delta_ms = sim_os_msec () - sim_throt_ms_start;
         if (delta_ms >= 10000) {                        /* recompute every 10 sec */
             double delta_insts = sim_gtime() - sim_throt_inst_start;
@@ -2064,11 +2229,11 @@ switch (sim_throt_state) {
                         while (1) {
                             sim_throt_wait = (int32)            /* cycles between sleeps */
                                 ((sim_throt_peak_cps * d_cps * ((double) sim_throt_sleep_time)) /
-                                 (1000.0 * (sim_throt_peak_cps - d_cps)));
+                                 (1000000.0 * (sim_throt_peak_cps - d_cps)));
                             if (sim_throt_wait >= SIM_THROT_WMIN)/* long enough? */
                                 break;
-                            sim_throt_sleep_time += sim_os_sleep_inc_ms;
-                            sim_debug (DBG_THR, &sim_timer_dev, "sim_throt_svc() Wait too small, increasing sleep time to %d ms.  Values a_cps = %f, d_cps = %f, wait = %d\n", 
+                            sim_throt_sleep_time += sim_os_sleep_min_us;
+                            sim_debug (DBG_THR, &sim_timer_dev, "sim_throt_svc() Wait too small, increasing sleep time to %d us.  Values a_cps = %f, d_cps = %f, wait = %d\n", 
                                                                 sim_throt_sleep_time, sim_throt_peak_cps, d_cps, sim_throt_wait);
                             }
                         }
@@ -2077,7 +2242,7 @@ switch (sim_throt_state) {
                                                             (int32)(((d_cps - a_cps) * (double)sim_throt_wait) / d_cps));
                         sim_throt_wait += (int32)(((d_cps - a_cps) * (double)sim_throt_wait) / d_cps);
                         }
-                    sim_debug (DBG_THR, &sim_timer_dev, "sim_throt_svc() Throttle values a_cps = %f, d_cps = %f, wait = %d, sleep = %d ms\n", 
+                    sim_debug (DBG_THR, &sim_timer_dev, "sim_throt_svc() Throttle values a_cps = %f, d_cps = %f, wait = %d, sleep = %d us\n", 
                                                         a_cps, d_cps, sim_throt_wait, sim_throt_sleep_time);
                     sim_throt_cps = d_cps;                      /* save the desired rate */
                     sim_throt_ms_start = sim_os_msec ();
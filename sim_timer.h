@@ -125,6 +125,9 @@ t_stat sim_show_throt (FILE *st, DEVICE *dnotused, UNIT *unotused, int32 flag, C
 t_stat sim_set_idle (UNIT *uptr, int32 val, CONST char *cptr, void *desc);
 t_stat sim_clr_idle (UNIT *uptr, int32 val, CONST char *cptr, void *desc);
 t_stat sim_show_idle (FILE *st, UNIT *uptr, int32 val, CONST void *desc);
+t_stat sim_set_fastio (UNIT *uptr, int32 val, CONST char *cptr, void *desc);
+t_stat sim_clr_fastio (UNIT *uptr, int32 val, CONST char *cptr, void *desc);
+t_stat sim_show_fastio (FILE *st, UNIT *uptr, int32 val, CONST void *desc);
 void sim_throt_sched (void);
 void sim_throt_cancel (void);
 uint32 sim_os_msec (void);
@@ -161,6 +164,7 @@ int32 sim_rom_read_with_delay (int32 val);
 double sim_host_speed_factor (void);
 
 extern t_bool sim_idle_enab;                        /* idle enabled flag */
+extern t_bool sim_fastio_enab;                      /* fast I/O enabled flag */
 extern volatile t_bool sim_idle_wait;               /* idle waiting flag */
 extern t_bool sim_asynch_timer;
 extern DEVICE sim_timer_dev;
@@ -448,6 +448,297 @@ static u_char mantra[] = {                  /* Telnet Option Negotiation Mantra
 
 static void tmxr_add_to_open_list (TMXR* mux);
 
+/* Receive readiness.
+
+   On Linux each multiplexer keeps an epoll set holding its listening socket
+   and the sockets of its connected Telnet/TCP lines.  A poll asks the kernel
+   once which of these have something pending, and only those are read or
+   accepted.  Serial ports, loopback lines and any socket which could not be
+   added to the set are still read on every poll.
+
+   Sockets are added as lines connect and removed before they are closed.
+   The receive poll also re-syncs any line whose socket changed by some other
+   path, so a missed hook costs a read per poll rather than lost input.
+
+   When built with asynchronous I/O support a helper thread waits on the
+   readiness sets of all open multiplexers.  If data arrives while the
+   simulator is idling, the polling unit of the line is activated right away,
+   which ends the idle sleep.
+*/
+
+#if defined(__linux__) && !defined(TMXR_NO_EPOLL)
+#define TMXR_EPOLL 1
+#include <sys/epoll.h>
+#endif
+
+#define TMXR_EPOLL_MASTER   0xFFFFFFFF              /* event tag of the listening socket */
+#define TMXR_EPOLL_EVENTS   256                     /* most events taken per poll */
+
+static t_bool tmxr_epoll_disabled = FALSE;          /* read every line every poll */
+
+#if defined(TMXR_EPOLL)
+
+#if defined(SIM_ASYNCH_IO)
+/* Idle wakeup
+
+   While the simulator sleeps in sim_idle, a thread blocks in epoll_wait
+   on a set holding the readiness set of each mux.  Each mux is registered
+   one shot, so once it has reported the thread ignores it until the
+   simulator has polled the mux and found it quiet (tmxr_idle_rearm).
+
+   tmxr_idle_lock is the mux lock for the thread: the list of registered
+   muxes, and the line poll units the thread activates, only change while
+   holding it.
+*/
+
+#include <sys/eventfd.h>
+
+static int tmxr_idle_fd = -1;                       /* set of mux readiness sets */
+static int tmxr_idle_stop_fd = -1;                  /* stops the thread */
+static TMXR **tmxr_idle_mux = NULL;                 /* muxes in that set */
+static int tmxr_idle_count = 0;
+static t_bool tmxr_idle_run = FALSE;               /* thread started */
+static pthread_t tmxr_idle_thread;
+static pthread_mutex_t tmxr_idle_lock = PTHREAD_MUTEX_INITIALIZER;
+
+#define TMXR_IDLE_LOCK      pthread_mutex_lock (&tmxr_idle_lock)
+#define TMXR_IDLE_UNLOCK    pthread_mutex_unlock (&tmxr_idle_lock)
+
+static t_bool _tmxr_idle_registered (TMXR *mp)
+{
+int i;
+
+for (i = 0; i < tmxr_idle_count; i++)
+    if (tmxr_idle_mux[i] == mp)
+        return TRUE;
+return FALSE;
+}
+
+static void *_tmxr_idle_wake (void *arg)
+{
+struct epoll_event ev, lev[16];
+int i, n;
+
+while (1) {
+    if (epoll_wait (tmxr_idle_fd, &ev, 1, -1) != 1)
+        continue;                                   /* interrupted */
+    if (ev.data.ptr == NULL)                        /* told to stop? */
+        break;
+    TMXR_IDLE_LOCK;
+    if (_tmxr_idle_registered ((TMXR *)ev.data.ptr)) {
+        TMXR *mp = (TMXR *)ev.data.ptr;
+
+        mp->epoll_armed = FALSE;
+        n = sim_idle_wait ? epoll_wait (mp->epoll_fd, lev, 16, 0) : 0;
+        for (i = 0; i < n; i++) {
+            UNIT *uptr = mp->uptr;
+
+            if ((lev[i].data.u32 != TMXR_EPOLL_MASTER) &&
+                (lev[i].data.u32 < (uint32)mp->lines) &&
+                (mp->ldsc[lev[i].data.u32].uptr))
+                uptr = mp->ldsc[lev[i].data.u32].uptr;
+            if (uptr)
+                sim_activate_abs (uptr, 0);
+            }
+        }
+    TMXR_IDLE_UNLOCK;
+    }
+return NULL;
+}
+
+static void tmxr_idle_add (TMXR *mp)
+{
+struct epoll_event ev;
+TMXR **muxes;
+t_bool start = FALSE;
+
+TMXR_IDLE_LOCK;
+if (tmxr_idle_fd < 0) {
+    tmxr_idle_fd = epoll_create1 (EPOLL_CLOEXEC);
+    tmxr_idle_stop_fd = eventfd (0, EFD_CLOEXEC);
+    memset (&ev, 0, sizeof (ev));
+    ev.events = EPOLLIN;
+    ev.data.ptr = NULL;
+    if ((tmxr_idle_fd >= 0) && (tmxr_idle_stop_fd >= 0) &&
+        (epoll_ctl (tmxr_idle_fd, EPOLL_CTL_ADD, tmxr_idle_stop_fd, &ev) != 0)) {
+        close (tmxr_idle_stop_fd);
+        tmxr_idle_stop_fd = -1;
+        }
+    }
+muxes = (TMXR **)realloc (tmxr_idle_mux, (tmxr_idle_count + 1) * sizeof (*muxes));
+if (muxes)
+    tmxr_idle_mux = muxes;
+memset (&ev, 0, sizeof (ev));
+ev.events = EPOLLIN | EPOLLONESHOT;
+ev.data.ptr = (void *)mp;
+if (muxes && (tmxr_idle_fd >= 0) && (tmxr_idle_stop_fd >= 0) &&
+    (epoll_ctl (tmxr_idle_fd, EPOLL_CTL_ADD, mp->epoll_fd, &ev) == 0)) {
+    tmxr_idle_mux[tmxr_idle_count++] = mp;
+    mp->epoll_armed = TRUE;
+    start = !tmxr_idle_run;
+    tmxr_idle_run = TRUE;
+    }
+TMXR_IDLE_UNLOCK;
+if (start)
+    pthread_create (&tmxr_idle_thread, NULL, _tmxr_idle_wake, NULL);
+}
+
+static void tmxr_idle_remove (TMXR *mp)
+{
+struct epoll_event ev;
+eventfd_t count;
+t_bool stop = FALSE;
+int i;
+
+TMXR_IDLE_LOCK;
+for (i = 0; i < tmxr_idle_count; i++)
+    if (tmxr_idle_mux[i] == mp) {
+        epoll_ctl (tmxr_idle_fd, EPOLL_CTL_DEL, mp->epoll_fd, &ev);
+        tmxr_idle_mux[i] = tmxr_idle_mux[--tmxr_idle_count];
+        stop = (tmxr_idle_count == 0);
+        break;
+        }
+mp->epoll = FALSE;
+mp->epoll_armed = FALSE;
+TMXR_IDLE_UNLOCK;
+if (stop && (eventfd_write (tmxr_idle_stop_fd, 1) == 0)) {
+    pthread_join (tmxr_idle_thread, NULL);
+    eventfd_read (tmxr_idle_stop_fd, &count);       /* reset for the next start */
+    tmxr_idle_run = FALSE;
+    }
+}
+
+/* Let the idle thread report the mux again once a poll found it quiet */
+
+static void tmxr_idle_rearm (TMXR *mp)
+{
+struct epoll_event ev;
+
+if (mp->epoll_armed)
+    return;
+memset (&ev, 0, sizeof (ev));
+ev.events = EPOLLIN | EPOLLONESHOT;
+ev.data.ptr = (void *)mp;
+TMXR_IDLE_LOCK;
+if (_tmxr_idle_registered (mp) &&
+    (epoll_ctl (tmxr_idle_fd, EPOLL_CTL_MOD, mp->epoll_fd, &ev) == 0))
+    mp->epoll_armed = TRUE;
+TMXR_IDLE_UNLOCK;
+}
+#else
+#define TMXR_IDLE_LOCK
+#define TMXR_IDLE_UNLOCK
+#define tmxr_idle_add(mp)
+#define tmxr_idle_remove(mp)    (mp)->epoll = FALSE
+#define tmxr_idle_rearm(mp)
+#endif /* defined(SIM_ASYNCH_IO) */
+
+/* Make the readiness set of a mux hold "sock" in place of "*watched".
+
+   The previous socket is only forgotten here, the caller is responsible
+   for removing it with tmxr_epoll_unwatch before closing it.
+*/
+
+static void tmxr_epoll_watch (TMXR *mp, SOCKET *watched, SOCKET sock, uint32 tag)
+{
+struct epoll_event ev;
+
+*watched = 0;
+if ((sock == 0) || (sock == INVALID_SOCKET) || tmxr_epoll_disabled)
+    return;
+if (!mp->epoll) {
+    mp->epoll_fd = epoll_create1 (EPOLL_CLOEXEC);
+    if (mp->epoll_fd < 0)
+        return;
+    mp->epoll = TRUE;
+    tmxr_idle_add (mp);
+    }
+memset (&ev, 0, sizeof (ev));
+ev.events = EPOLLIN;
+ev.data.u32 = tag;
+if (epoll_ctl (mp->epoll_fd, EPOLL_CTL_ADD, (int)sock, &ev) == 0)
+    *watched = sock;
+}
+
+static void tmxr_epoll_unwatch (TMXR *mp, SOCKET *watched)
+{
+struct epoll_event ev;
+
+if (*watched && mp && mp->epoll)
+    epoll_ctl (mp->epoll_fd, EPOLL_CTL_DEL, (int)*watched, &ev);
+*watched = 0;
+}
+
+static void tmxr_epoll_watch_line (TMLN *lp)
+{
+if (lp->mp && !lp->serport && !lp->loopback)
+    tmxr_epoll_watch (lp->mp, &lp->epoll_sock, lp->sock, (uint32)(lp - lp->mp->ldsc));
+}
+
+static void tmxr_epoll_close (TMXR *mp)
+{
+int32 i;
+
+if (!mp->epoll)
+    return;
+tmxr_idle_remove (mp);
+close (mp->epoll_fd);
+mp->epoll_master = 0;
+mp->conn_ready = FALSE;
+for (i = 0; i < mp->lines; i++) {
+    mp->ldsc[i].epoll_sock = 0;
+    mp->ldsc[i].rx_ready = FALSE;
+    }
+}
+
+/* Collect readiness, returns FALSE if every line must be polled */
+
+static t_bool tmxr_epoll_collect (TMXR *mp)
+{
+struct epoll_event ev[TMXR_EPOLL_EVENTS];
+int i, n;
+
+if (!mp->epoll || tmxr_epoll_disabled)
+    return FALSE;
+n = epoll_wait (mp->epoll_fd, ev, TMXR_EPOLL_EVENTS, 0);
+if (n < 0)
+    return FALSE;
+if (n == 0)
+    tmxr_idle_rearm (mp);
+for (i = 0; i < n; i++) {
+    if (ev[i].data.u32 == TMXR_EPOLL_MASTER)
+        mp->conn_ready = TRUE;
+    else if (ev[i].data.u32 < (uint32)mp->lines)
+        mp->ldsc[ev[i].data.u32].rx_ready = TRUE;
+    }
+return TRUE;
+}
+
+/* Check for a waiting incoming connection on the mux listening socket */
+
+static t_bool tmxr_epoll_conn_pending (TMXR *mp)
+{
+if (mp->epoll_master != mp->master)
+    tmxr_epoll_watch (mp, &mp->epoll_master, mp->master, TMXR_EPOLL_MASTER);
+if (mp->epoll_master == 0)
+    return TRUE;
+if (!mp->conn_ready && !tmxr_epoll_collect (mp))
+    return TRUE;
+if (!mp->conn_ready)
+    return FALSE;
+mp->conn_ready = FALSE;
+return TRUE;
+}
+#else
+#define TMXR_IDLE_LOCK
+#define TMXR_IDLE_UNLOCK
+#define tmxr_epoll_watch_line(lp)
+#define tmxr_epoll_unwatch(mp, watched)
+#define tmxr_epoll_close(mp)
+#define tmxr_epoll_collect(mp)          FALSE
+#define tmxr_epoll_conn_pending(mp)     TRUE
+#endif /* defined(TMXR_EPOLL) */
+
 /* Initialize the line state.
 
    Reset the line state to represent an idle line.  Note that we do not clear
@@ -493,6 +784,7 @@ if (lp->txpb) {
     lp->txpb = NULL;
     }
 memset (lp->rbr, 0, lp->rxbsz);                         /* clear break status array */
+tmxr_epoll_watch_line (lp);                             /* watch for input */
 }
 
 
@@ -1061,8 +1353,10 @@ if (mp->master) {
         address = mp->ring_ipad;
         mp->ring_ipad = NULL;
         }
-    else
+    else if (tmxr_epoll_conn_pending (mp))
         newsock = sim_accept_conn_ex (mp->master, &address, (mp->packet ? SIM_SOCK_OPT_NODELAY : 0));/* poll connect */
+    else
+        newsock = INVALID_SOCKET;                       /* nothing waiting */
 
     if (newsock != INVALID_SOCKET) {                    /* got a live one? */
         snprintf (msg, sizeof (msg) - 1, "tmxr_poll_conn() - Connection from %s", address);
@@ -1198,6 +1492,7 @@ for (i = 0; i < mp->lines; i++) {                       /* check each line in se
                             lp->conn = TRUE;                    /* record connection */
                             lp->sock = lp->connecting;          /* it now looks normal */
                             lp->connecting = 0;
+                            tmxr_epoll_watch_line (lp);         /* watch for input */
                             lp->ipad = (char *)realloc (lp->ipad, 1+strlen (lp->destination));
                             strcpy (lp->ipad, lp->destination);
                             lp->cnms = sim_os_msec ();
@@ -1344,6 +1639,7 @@ if (lp->serport) {
     }
 else                                                    /* Telnet connection */
     if (lp->sock) {
+        tmxr_epoll_unwatch (lp->mp, &lp->epoll_sock);   /* stop watching */
         sim_close_sock (lp->sock);                      /* close socket */
         free (lp->telnet_sent_opts);
         lp->telnet_sent_opts = NULL;
@@ -2019,13 +2315,20 @@ void tmxr_poll_rx (TMXR *mp)
 {
 int32 i, nbytes, j;
 TMLN *lp;
+t_bool ready_only;
 
 tmxr_debug_trace (mp, "tmxr_poll_rx()");
+ready_only = tmxr_epoll_collect (mp);                   /* find lines with input */
 for (i = 0; i < mp->lines; i++) {                       /* loop thru lines */
     lp = mp->ldsc + i;                                  /* get line desc */
     if (!(lp->sock || lp->serport || lp->loopback) || 
         !(lp->rcve))                                    /* skip if not connected */
         continue;
+    if (lp->sock != lp->epoll_sock)                     /* socket changed? */
+        tmxr_epoll_watch_line (lp);
+    if (ready_only && lp->epoll_sock && !lp->rx_ready)  /* watched and nothing there? */
+        continue;
+    lp->rx_ready = FALSE;
 
     nbytes = 0;
     if (lp->rxbpi == 0)                                 /* need input? */
@@ -3023,6 +3326,7 @@ while (*tptr) {
             if (sock == INVALID_SOCKET)                     /* open error */
                 return sim_messagef (SCPE_OPENERR, "Can't open network socket for listen port: %s\n", listen);
             if (mp->port) {                                 /* close prior listener */
+                tmxr_epoll_unwatch (mp, &mp->epoll_master);
                 sim_close_sock (mp->master);
                 mp->master = 0;
                 free (mp->port);
@@ -3293,7 +3597,9 @@ if ((line < 0) || (line >= mp->lines))
     return SCPE_ARG;
 if (mp->ldsc[line].uptr)
     mp->ldsc[line].uptr->dynflags &= ~UNIT_TM_POLL;
+TMXR_IDLE_LOCK;
 mp->ldsc[line].uptr = uptr_poll;
+TMXR_IDLE_UNLOCK;
 if (uptr_poll->tmxr)                /* associated with a TMXR? */
     mp->ldsc[line].uptr->dynflags |= UNIT_TM_POLL;
 return SCPE_OK;
@@ -4330,6 +4636,7 @@ for (i = 0; i < mp->lines; i++) {  /* loop thru conn */
     lp->modembits = 0;
     }
 
+tmxr_epoll_unwatch (mp, &mp->epoll_master);
 if (mp->master)
     sim_close_sock (mp->master);                        /* close master socket */
 mp->master = 0;
@@ -4342,6 +4649,7 @@ if (mp->ring_sock != INVALID_SOCKET) {
     mp->ring_ipad = NULL;
     mp->ring_start_time = 0;
     }
+tmxr_epoll_close (mp);                                  /* drop readiness set */
 _tmxr_remove_from_open_list (mp);
 return SCPE_OK;
 }
@@ -5610,6 +5918,77 @@ if ((dptr) && (dbits & dptr->dctrl)) {
 
 #include <setjmp.h>
 
+/* Receive poll cost with many connected lines.
+
+   A private mux with 128 lines is opened on a localhost port and a client
+   socket is connected to each line.  The cost of tmxr_poll_rx is then
+   measured with all lines idle and with a character waiting on every line,
+   both with the receive readiness set and with every line being read.
+*/
+
+#define TMXR_BENCH_LINES    128
+#define TMXR_BENCH_POLLS    1000
+
+static t_stat tmxr_rx_bench (void)
+{
+static TMLN ldsc[TMXR_BENCH_LINES];
+static TMXR mux = { TMXR_BENCH_LINES, 0, 0, ldsc };
+static UNIT poll_unit = { UDATA (NULL, 0, 0) };
+SOCKET sock[TMXR_BENCH_LINES];
+int32 i, j, lines, pass, busy, chars;
+double start, elapsed;
+t_stat r;
+
+mux.notelnet = TRUE;
+r = tmxr_open_master (&mux, "localhost:65502");
+if (r != SCPE_OK)
+    return r;
+mux.uptr = &poll_unit;
+poll_unit.dynflags |= TMUF_NOASYNCH;
+for (lines = 0; lines < TMXR_BENCH_LINES; lines++) {
+    sock[lines] = sim_connect_sock_ex (NULL, "localhost:65502", NULL, NULL, 0);
+    for (i = 0; (i < 1000) && (tmxr_poll_conn (&mux) < 0); i++)
+        sim_os_ms_sleep (1);
+    if (i == 1000) {
+        sim_close_sock (sock[lines]);
+        break;
+        }
+    }
+for (i = 0; i < lines; i++)
+    ldsc[i].rcve = 1;
+sim_printf ("tmxr_poll_rx cost with %d connected lines:\n", lines);
+for (pass = 0; pass < 2; pass++) {
+    tmxr_epoll_disabled = (pass != 0);
+    for (busy = 0; busy < 2; busy++) {
+        elapsed = 0.0;
+        chars = 0;
+        for (i = 0; i < TMXR_BENCH_POLLS; i++) {
+            if (busy) {
+                for (j = 0; j < lines; j++)
+                    sim_write_sock (sock[j], "x", 1);
+                }
+            start = sim_timenow_double ();
+            tmxr_poll_rx (&mux);
+            elapsed += sim_timenow_double () - start;
+            for (j = 0; j < lines; j++)
+                while (tmxr_getc_ln (&ldsc[j]))
+                    ++chars;
+            }
+        if (chars != (busy ? lines * TMXR_BENCH_POLLS : 0))
+            r = SCPE_IERR;                          /* input lost or invented */
+        sim_printf ("  %-12s %s lines: %8.2f usecs/poll\n", pass ? "read all" : "readiness", busy ? "busy" : "idle", 
+                    (elapsed * 1000000.0) / TMXR_BENCH_POLLS);
+        }
+    }
+tmxr_epoll_disabled = FALSE;
+for (i = 0; i < lines; i++)
+    sim_close_sock (sock[i]);
+tmxr_close_master (&mux);
+if (lines != TMXR_BENCH_LINES)
+    r = SCPE_IERR;
+return r;
+}
+
 t_stat tmxr_sock_test (DEVICE *dptr)
 {
 char cmd[CBUFSIZE], host[CBUFSIZE], port[CBUFSIZE];
@@ -5620,6 +5999,7 @@ int32 tmp1, tmp2;
 t_stat stat = SCPE_OK;
 SOCKET sock_mux = INVALID_SOCKET;
 SOCKET sock_line = INVALID_SOCKET;
+static t_bool benched = FALSE;
 SIM_TEST_INIT;
 
 sim_printf ("Testing %s:\n", dptr->name);
@@ -5631,6 +6011,10 @@ SIM_TEST((sim_parse_addr ("localhost:6666", host, sizeof(host), "localhost", por
 SIM_TEST(sim_parse_addr ("localhost:66666", host, sizeof(host), "localhost", port, sizeof(port), "1234", NULL) != -1);
 SIM_TEST((sim_parse_addr ("localhost:telnet", host, sizeof(host), "localhost", port, sizeof(port), "1234", NULL) == -1) || (strcmp(host, "localhost")) || (strcmp(port,"telnet")));
 SIM_TEST((sim_parse_addr ("telnet", host, sizeof(host), "localhost", port, sizeof(port), "1234", NULL) == -1) || (strcmp(host, "localhost")) || (strcmp(port,"telnet")));
+if (!benched) {                                     /* poll cost once per run */
+    benched = TRUE;
+    SIM_TEST(tmxr_rx_bench ());
+    }
 dptr->dctrl = 0xFFFFFFFF;
 dptr->dctrl &= ~TMXR_DBG_TRC;
 sprintf (cmd, "%s -u localhost:65500;notelnet", dptr->name);
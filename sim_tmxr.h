@@ -206,6 +206,8 @@ struct tmln {
     DEVICE              *dptr;                          /* line specific device */
     EXPECT              expect;                         /* Expect rules */
     SEND                send;                           /* Send input state */
+    SOCKET              epoll_sock;                     /* socket in mux receive readiness set - private */
+    t_bool              rx_ready;                       /* receive readiness reported - private */
     };
 
 struct tmxr {
@@ -231,6 +233,11 @@ struct tmxr {
     t_bool              port_speed_control;             /* multiplexer programmatically sets port speed */
     t_bool              packet;                         /* Lines are packet oriented */
     t_bool              datagram;                       /* Lines use datagram packet transport */
+    t_bool              epoll;                          /* receive readiness set open - private */
+    int                 epoll_fd;                       /* receive readiness set - private */
+    SOCKET              epoll_master;                   /* master socket in readiness set - private */
+    t_bool              epoll_armed;                    /* idle wakeup armed for readiness set - private */
+    t_bool              conn_ready;                     /* connection readiness reported - private */
     };
 
 int32 tmxr_poll_conn (TMXR *mp);